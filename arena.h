@@ -0,0 +1,180 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+#ifndef ARENA_H
+#define ARENA_H
+
+//Slab allocator for the nodes of a single heap. Nodes are taken from
+//the free list or from the current slab. All slabs are released at once
+//when the arena is destroyed. The arena is not thread-safe.
+template <typename T>
+class NodeArena final {
+    private:
+        static const size_t minSlabNodes = 64;
+        static const size_t maxSlabNodes = 65536;
+
+        struct Slab {
+            Slab* next;
+            T* nodes;
+            size_t capacity;
+        } *slabs, *lastSlab;
+
+        //Released nodes are chained through their own storage
+        struct FreeNode {
+            FreeNode* next;
+        } *freeNodes, *lastFreeNode;
+
+        //Nodes taken from the first slab and the size of all slabs
+        size_t slabUsed;
+        size_t slabBytes;
+
+        void addSlab(size_t minCapacity = 0) {
+            //The slabs grow up to a fixed size
+            size_t capacity = minSlabNodes;
+
+            if (slabs != NULL) {
+                capacity = slabs->capacity * 2;
+            }
+
+            if (capacity > maxSlabNodes) {
+                capacity = maxSlabNodes;
+            }
+
+            //Reserved slabs can be larger than the limit
+            if (capacity < minCapacity) {
+                capacity = minCapacity;
+            }
+
+            Slab* slab = new Slab;
+            slab->capacity = capacity;
+            slab->nodes = static_cast<T*>(::operator new(slab->capacity * sizeof(T)));
+
+            //The newest slab is the first one
+            slab->next = slabs;
+            slabs = slab;
+            slabUsed = 0;
+            slabBytes += slab->capacity * sizeof(T) + sizeof(Slab);
+
+            if (lastSlab == NULL) {
+                lastSlab = slab;
+            }
+        }
+
+    public:
+        NodeArena() {
+            slabs = lastSlab = NULL;
+            freeNodes = lastFreeNode = NULL;
+            slabUsed = 0;
+            slabBytes = 0;
+        }
+
+        ~NodeArena() {
+            clear();
+        }
+
+        //Every heap owns its own nodes
+        NodeArena(const NodeArena<T>&) = delete;
+        NodeArena<T>& operator=(const NodeArena<T>&) = delete;
+
+        //Uninitialized storage for a single node
+        T* allocate() {
+            if (freeNodes != NULL) {
+                FreeNode* node = freeNodes;
+                freeNodes = node->next;
+
+                if (freeNodes == NULL) {
+                    lastFreeNode = NULL;
+                }
+
+                return reinterpret_cast<T*>(node);
+            }
+
+            if (slabs == NULL || slabUsed == slabs->capacity) {
+                addSlab();
+            }
+
+            return &slabs->nodes[slabUsed++];
+        }
+
+        //Room for count nodes in a single contiguous slab
+        void reserve(size_t count) {
+            if (slabs == NULL || slabs->capacity - slabUsed < count) {
+                addSlab(count);
+            }
+        }
+
+        //The node must already be destroyed
+        void release(T* node) {
+            static_assert(sizeof(T) >= sizeof(FreeNode), "Nodes must be able to hold a pointer");
+            FreeNode* freeNode = reinterpret_cast<FreeNode*>(node);
+            freeNode->next = freeNodes;
+            freeNodes = freeNode;
+
+            if (lastFreeNode == NULL) {
+                lastFreeNode = freeNode;
+            }
+        }
+
+        //Take over all slabs and free nodes of the other arena in O(1)
+        void merge(NodeArena<T>* other) {
+            if (other == this || other->slabs == NULL) {
+                return;
+            }
+
+            if (slabs == NULL) {
+                slabs = other->slabs;
+                lastSlab = other->lastSlab;
+                slabUsed = other->slabUsed;
+
+            } else {
+                //The remaining space of the other first slab is not used anymore
+                lastSlab->next = other->slabs;
+                lastSlab = other->lastSlab;
+            }
+
+            if (other->freeNodes != NULL) {
+                other->lastFreeNode->next = freeNodes;
+                freeNodes = other->freeNodes;
+
+                if (lastFreeNode == NULL) {
+                    lastFreeNode = other->lastFreeNode;
+                }
+            }
+
+            slabBytes += other->slabBytes;
+
+            other->slabs = other->lastSlab = NULL;
+            other->freeNodes = other->lastFreeNode = NULL;
+            other->slabUsed = 0;
+            other->slabBytes = 0;
+        }
+
+        //Release all slabs without destroying the nodes
+        void clear() {
+            while (slabs != NULL) {
+                Slab* next = slabs->next;
+                ::operator delete(slabs->nodes);
+                delete slabs;
+                slabs = next;
+            }
+
+            lastSlab = NULL;
+            freeNodes = lastFreeNode = NULL;
+            slabUsed = 0;
+            slabBytes = 0;
+        }
+
+        //Bytes of all slabs including their headers
+        size_t bytes() const {
+            return slabBytes;
+        }
+};
+
+#endif /* ARENA_H */
@@ -0,0 +1,58 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "fibheap.h"
+#include "coalescingheap.h"
+using namespace std;
+
+//Coarse timestamps as keys, every extraction is followed by two inserts
+//with a key in a window above the current minimum
+template <typename Heap>
+double run(unsigned int n, int window) {
+    mt19937 rng(42);
+    Heap heap;
+    int now = 0;
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < n; i++) {
+        heap.insert(now + (int)(rng() % window), i);
+    }
+
+    for (unsigned int i = 0; i < n; i++) {
+        now = heap.getMinKey();
+        heap.extractMin();
+        heap.insert(now + (int)(rng() % window), i);
+        heap.insert(now + (int)(rng() % window), i);
+    }
+
+    while (!heap.isEmpty()) {
+        heap.extractMin();
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main() {
+    const unsigned int n = 1000000;
+
+    cout << "Inserts and extractions of " << 3 * n << " elements with keys from a window" << endl;
+    cout << setw(10) << "keys" << setw(15) << "fibonacci" << setw(15) << "coalescing" << endl;
+
+    for (int window : {16, 1024, 65536, 1 << 24}) {
+        cout << setw(10) << window << fixed << setprecision(1)
+             << setw(12) << run<FibonacciHeap<int,int>>(n, window) << " ms"
+             << setw(12) << run<CoalescingHeap<int,int>>(n, window) << " ms" << endl;
+    }
+
+    return 0;
+}
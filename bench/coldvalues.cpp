@@ -0,0 +1,67 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "fibheap.h"
+#include "payload.h"
+using namespace std;
+
+//Inserts, decreases through handles and extractions of all elements
+template <typename V>
+double run(unsigned int n) {
+    mt19937 rng(42);
+    FibonacciHeap<int,V> heap;
+    vector<typename FibonacciHeap<int,V>::Handle> handles(n);
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < n; i++) {
+        handles[i] = heap.insert((int)(rng() >> 2), V((int)i));
+    }
+
+    //Half of the elements are extracted before the decreases
+    vector<bool> extracted(n, false);
+
+    for (unsigned int i = 0; i < n / 2; i++) {
+        extracted[heap.extractMin().id] = true;
+    }
+
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int target = rng() % n;
+
+        if (!extracted[target]) {
+            heap.decreaseKey(handles[target], heap.getKey(handles[target]) - (int)(rng() % 1024) - 1);
+        }
+    }
+
+    while (!heap.isEmpty()) {
+        heap.extractMin();
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main() {
+    const unsigned int n = 1000000;
+
+    cout << "Inserts, decreases and extractions of " << n << " elements" << endl;
+    cout << setw(10) << "value" << setw(15) << "inline" << setw(15) << "cold" << endl;
+
+    cout << setw(10) << "64 bytes" << fixed << setprecision(1)
+         << setw(12) << run<Payload<64,false>>(n) << " ms"
+         << setw(12) << run<Payload<64,true>>(n) << " ms" << endl;
+
+    cout << setw(10) << "256 bytes" << fixed << setprecision(1)
+         << setw(12) << run<Payload<256,false>>(n) << " ms"
+         << setw(12) << run<Payload<256,true>>(n) << " ms" << endl;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "fibheap.h"
+using namespace std;
+
+//Build a heap after a long churn that scatters the nodes over the slabs
+void churn(FibonacciHeap<int,int>& heap, unsigned int n) {
+    mt19937 rng(42);
+
+    for (unsigned int i = 0; i < 8 * n; i++) {
+        heap.insert((int)(rng() >> 1), i);
+    }
+
+    for (unsigned int i = 0; i < 7 * n; i++) {
+        heap.extractMin();
+        heap.insert((int)(rng() >> 1), 8 * n + i);
+        heap.extractMin();
+    }
+}
+
+//Searches for missing values walk all nodes, followed by extractions
+void measure(FibonacciHeap<int,int>& heap, const char* name) {
+    auto start = chrono::steady_clock::now();
+
+    for (int i = 0; i < 20; i++) {
+        heap.decreaseKey(-1, 0);
+    }
+
+    auto mid = chrono::steady_clock::now();
+
+    while (!heap.isEmpty()) {
+        heap.extractMin();
+    }
+
+    auto end = chrono::steady_clock::now();
+
+    cout << setw(12) << name << fixed << setprecision(1)
+         << setw(12) << chrono::duration<double, milli>(mid - start).count() << " ms"
+         << setw(12) << chrono::duration<double, milli>(end - mid).count() << " ms" << endl;
+}
+
+int main() {
+    const unsigned int n = 1000000;
+    FibonacciHeap<int,int> heap;
+    churn(heap, n);
+
+    cout << "Heap with " << heap.size() << " elements after a churn of " << 8 * n << " elements" << endl;
+    cout << "Memory before compaction: " << heap.memoryUsage() / 1024 << " KiB" << endl;
+
+    //A copy would already be compact, so the same churn is repeated
+    FibonacciHeap<int,int> compacted;
+    churn(compacted, n);
+
+    auto start = chrono::steady_clock::now();
+    compacted.compact();
+    auto end = chrono::steady_clock::now();
+
+    cout << "Memory after compaction: " << compacted.memoryUsage() / 1024 << " KiB in "
+         << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    cout << setw(12) << "heap" << setw(15) << "20 searches" << setw(15) << "extract all" << endl;
+
+    measure(heap, "churned");
+    measure(compacted, "compacted");
+    return 0;
+}
@@ -0,0 +1,141 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <climits>
+
+#include "fibheap.h"
+#include "radixheap.h"
+#include "pairingheap.h"
+#include "rpheap.h"
+using namespace std;
+
+//Adjacency list with (target, weight) pairs
+typedef vector<vector<pair<int,int>>> Graph;
+
+Graph randomGraph(int vertices, int degree, int maxWeight, unsigned int seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> vertex(0, vertices - 1);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    Graph g(vertices);
+
+    for (int v = 0; v < vertices; v++) {
+        //Chain all vertices to keep the graph connected
+        g[v].push_back(make_pair((v + 1) % vertices, weight(rng)));
+
+        for (int i = 1; i < degree; i++) {
+            g[v].push_back(make_pair(vertex(rng), weight(rng)));
+        }
+    }
+
+    return g;
+}
+
+Graph gridGraph(int width, int maxWeight, unsigned int seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    Graph g(width * width);
+
+    for (int y = 0; y < width; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = y * width + x;
+
+            if (x + 1 < width) {
+                g[v].push_back(make_pair(v + 1, weight(rng)));
+                g[v + 1].push_back(make_pair(v, weight(rng)));
+            }
+
+            if (y + 1 < width) {
+                g[v].push_back(make_pair(v + width, weight(rng)));
+                g[v + width].push_back(make_pair(v, weight(rng)));
+            }
+        }
+    }
+
+    return g;
+}
+
+//Dijkstra with lazy deletion: a vertex is inserted again for every shorter
+//path and only its first extraction is settled
+template <typename Heap>
+long long dijkstra(const Graph& g, int source) {
+    vector<int> dist(g.size(), INT_MAX);
+    vector<bool> settled(g.size(), false);
+    Heap heap;
+
+    dist[source] = 0;
+    heap.insert(0, source);
+
+    while (!heap.isEmpty()) {
+        int u = heap.extractMin();
+
+        if (settled[u]) {
+            continue;
+        }
+
+        settled[u] = true;
+
+        for (const pair<int,int>& edge : g[u]) {
+            int d = dist[u] + edge.second;
+
+            if (d < dist[edge.first]) {
+                dist[edge.first] = d;
+                heap.insert(d, edge.first);
+            }
+        }
+    }
+
+    long long checksum = 0;
+
+    for (int d : dist) {
+        checksum += (d == INT_MAX) ? 0 : d;
+    }
+
+    return checksum;
+}
+
+template <typename Heap>
+void run(const string& engine, const string& graphName, const Graph& g, unsigned int runs) {
+    auto start = chrono::steady_clock::now();
+    long long checksum = 0;
+
+    for (unsigned int i = 0; i < runs; i++) {
+        checksum += dijkstra<Heap>(g, (i * 7919) % g.size());
+    }
+
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(end - start).count() / runs;
+
+    cout << left << setw(12) << graphName << setw(16) << engine
+         << right << setw(10) << fixed << setprecision(2) << ms << " ms"
+         << "   checksum " << checksum << endl;
+}
+
+int main() {
+    const unsigned int runs = 5;
+
+    Graph graphs[] = {
+        randomGraph(100000, 8, 1000, 42),
+        randomGraph(200000, 4, 100000, 43),
+        gridGraph(400, 100, 44)
+    };
+
+    string names[] = {"random-8", "random-4", "grid-400"};
+
+    cout << "Dijkstra single source, average of " << runs << " runs" << endl;
+
+    for (unsigned int i = 0; i < sizeof(graphs)/sizeof(graphs[0]); i++) {
+        run<FibonacciHeap<int,int>>("FibonacciHeap", names[i], graphs[i], runs);
+        run<PairingHeap<int,int>>("PairingHeap", names[i], graphs[i], runs);
+        run<RankPairingHeap<int,int>>("RankPairing", names[i], graphs[i], runs);
+        run<RadixHeap<int,int>>("RadixHeap", names[i], graphs[i], runs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "graph.h"
+#include "pairingheap.h"
+#include "rpheap.h"
+using namespace std;
+
+template <typename Func>
+double measure(Func func, long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    checksum = func();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+//Dijkstra from a few sources, A* between opposite grid corners and Prim
+template <template <typename, typename> class Heap>
+void run(const string& engine, const string& graphName, const CsrGraph& graph, uint32_t width) {
+    long long dijkstraSum, astarSum, primSum;
+
+    double dijkstraTime = measure([&graph]() {
+        long long sum = 0;
+
+        for (uint32_t i = 0; i < 3; i++) {
+            ShortestPaths paths = dijkstra<Heap>(graph, (i * 7919) % graph.vertexCount());
+            sum += paths.distance[graph.vertexCount() / 2];
+        }
+
+        return sum;
+    }, dijkstraSum);
+
+    //Manhattan distance to the last vertex, zero for graphs without a grid
+    uint32_t target = graph.vertexCount() - 1;
+    auto heuristic = [width, target](uint32_t v) -> long long {
+        if (width == 0) {
+            return 0;
+        }
+
+        return abs((int)(v % width) - (int)(target % width)) + abs((int)(v / width) - (int)(target / width));
+    };
+
+    double astarTime = measure([&graph, &heuristic, target]() {
+        return astar<Heap>(graph, 0, target, heuristic);
+    }, astarSum);
+
+    double primTime = measure([&graph]() {
+        return prim<Heap>(graph);
+    }, primSum);
+
+    cout << left << setw(12) << graphName << setw(16) << engine << right << fixed << setprecision(1)
+         << setw(10) << dijkstraTime << " ms" << setw(10) << astarTime << " ms" << setw(10) << primTime << " ms"
+         << "   checksums " << dijkstraSum << " " << astarSum << " " << primSum << endl;
+}
+
+void runAll(const string& graphName, const CsrGraph& graph, uint32_t width) {
+    run<FibonacciHeap>("FibonacciHeap", graphName, graph, width);
+    run<PairingHeap>("PairingHeap", graphName, graph, width);
+    run<RankPairingHeap>("RankPairing", graphName, graph, width);
+}
+
+int main(int argc, char** argv) {
+    cout << setw(41) << "3x dijkstra" << setw(13) << "astar" << setw(13) << "prim" << endl;
+
+    //A DIMACS file replaces the synthetic graphs
+    if (argc > 1) {
+        ifstream file(argv[1]);
+        CsrGraph graph;
+        string error;
+
+        if (!loadDimacs(file, graph, error)) {
+            cerr << argv[1] << ": " << error << endl;
+            return 1;
+        }
+
+        runAll("dimacs", graph, 0);
+        return 0;
+    }
+
+    //Prim requires undirected graphs, four edges per vertex in both directions
+    runAll("random-8", randomGraph(200000, 4, 1000, 42, true), 0);
+    runAll("grid-500", gridGraph(500, 100, 44), 500);
+    return 0;
+}
@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "kwaymerge.h"
+using namespace std;
+
+//Sorted log files with a timestamp as the first field. Interleaved files
+//cover the same time range, rotated segments overlap their neighbours by 10%.
+vector<string> generate(const string& directory, unsigned int files, unsigned int lines,
+                        bool rotated, size_t& bytes) {
+    mt19937 rng(17);
+    uniform_int_distribution<int> step(0, 2000);
+    vector<string> paths;
+    bytes = 0;
+
+    for (unsigned int f = 0; f < files; f++) {
+        string path = directory + "/segment-" + to_string(f) + ".log";
+        ofstream out(path);
+        long long timestamp = 1500000000000LL + (rotated ? (long long)f * lines * 900 : 0);
+
+        for (unsigned int i = 0; i < lines; i++) {
+            timestamp += step(rng);
+            string line = to_string(timestamp) + " worker-" + to_string(f) + " request " + to_string(i) + " done\n";
+            out << line;
+            bytes += line.size();
+        }
+
+        paths.push_back(path);
+    }
+
+    return paths;
+}
+
+double mergeHeap(const vector<string>& paths, const string& output, bool map, size_t& records) {
+    auto start = chrono::steady_clock::now();
+    int fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    vector<MergeInput> inputs(paths.size());
+    string error;
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        inputs[i].open(paths[i], map, 1 << 20, error);
+    }
+
+    {
+        MergeWriter writer(fd);
+
+        if (!kwayMerge(inputs, writer, 1, records, error)) {
+            cerr << error << endl;
+            exit(1);
+        }
+    }
+
+    close(fd);
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//Typical glue code with streams and a binary heap of keys and input indices
+double mergeStreams(const vector<string>& paths, const string& output, size_t& records) {
+    auto start = chrono::steady_clock::now();
+    vector<ifstream> inputs(paths.size());
+    vector<string> heads(paths.size());
+    priority_queue<pair<long long,size_t>, vector<pair<long long,size_t>>, greater<pair<long long,size_t>>> queue;
+    ofstream out(output);
+    records = 0;
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        inputs[i].open(paths[i]);
+
+        if (getline(inputs[i], heads[i])) {
+            queue.push(make_pair(atoll(heads[i].c_str()), i));
+        }
+    }
+
+    while (!queue.empty()) {
+        size_t i = queue.top().second;
+        queue.pop();
+        out << heads[i] << '\n';
+        records++;
+
+        if (getline(inputs[i], heads[i])) {
+            queue.push(make_pair(atoll(heads[i].c_str()), i));
+        }
+    }
+
+    out.close();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    unsigned int files = (argc > 1) ? (unsigned int)atoi(argv[1]) : 256;
+    unsigned int lines = (argc > 2) ? (unsigned int)atoi(argv[2]) : 20000;
+
+    char directory[] = "/tmp/kwaymerge-XXXXXX";
+
+    if (mkdtemp(directory) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    string output = string(directory) + "/merged.log";
+    vector<string> paths;
+
+    for (int rotated = 0; rotated < 2; rotated++) {
+        size_t bytes;
+        paths = generate(directory, files, lines, rotated != 0, bytes);
+
+        cout << files << (rotated ? " rotated" : " interleaved") << " files with " << lines << " lines, "
+             << fixed << setprecision(1) << bytes / 1e6 << " MB" << endl;
+
+        size_t records;
+        double seconds = mergeStreams(paths, output, records);
+        cout << left << setw(28) << "ifstream + priority_queue" << right << setw(8) << bytes / 1e6 / seconds
+             << " MB/s  " << records << " records" << endl;
+
+        seconds = mergeHeap(paths, output, false, records);
+        cout << left << setw(28) << "kwayMerge buffered" << right << setw(8) << bytes / 1e6 / seconds
+             << " MB/s  " << records << " records" << endl;
+
+        seconds = mergeHeap(paths, output, true, records);
+        cout << left << setw(28) << "kwayMerge mapped" << right << setw(8) << bytes / 1e6 / seconds
+             << " MB/s  " << records << " records" << endl;
+    }
+
+    for (const string& path : paths) {
+        unlink(path.c_str());
+    }
+
+    unlink(output.c_str());
+    rmdir(directory);
+    return 0;
+}
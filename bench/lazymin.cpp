@@ -0,0 +1,52 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "fibheap.h"
+using namespace std;
+
+//Every extraction is followed by a number of inserts
+double run(bool lazy, unsigned int n, unsigned int insertsPerExtract) {
+    mt19937 rng(42);
+    FibonacciHeap<int,int> heap;
+    heap.setLazy(lazy);
+
+    for (unsigned int i = 0; i < n; i++) {
+        heap.insert((int)(rng() >> 1), i);
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < n; i++) {
+        heap.extractMin();
+
+        for (unsigned int j = 0; j < insertsPerExtract; j++) {
+            heap.insert((int)(rng() >> 1), i);
+        }
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main() {
+    const unsigned int n = 1000000;
+
+    cout << "Alternating extractMin and inserts on " << n << " elements" << endl;
+    cout << setw(10) << "inserts" << setw(15) << "eager" << setw(15) << "lazy" << endl;
+
+    for (unsigned int inserts : {1, 2, 4, 8}) {
+        cout << setw(10) << inserts << fixed << setprecision(1)
+             << setw(12) << run(false, n, inserts) << " ms"
+             << setw(12) << run(true, n, inserts) << " ms" << endl;
+    }
+
+    return 0;
+}
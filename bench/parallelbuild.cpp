@@ -0,0 +1,58 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+
+#include "fibheap.h"
+using namespace std;
+
+//Build time and time of the first extractMin for a number of threads
+void run(const vector<pair<int,int>>& items, unsigned int threads, bool consolidateTrees) {
+    FibonacciHeap<int,int>* heap = new FibonacciHeap<int,int>();
+
+    auto start = chrono::steady_clock::now();
+    heap->insertParallel(items.data(), items.size(), threads, consolidateTrees);
+    auto built = chrono::steady_clock::now();
+    heap->extractMin();
+    auto extracted = chrono::steady_clock::now();
+
+    cout << setw(8) << threads << setw(14) << (consolidateTrees ? "yes" : "no")
+         << fixed << setprecision(1)
+         << setw(12) << chrono::duration<double, milli>(built - start).count() << " ms"
+         << setw(12) << chrono::duration<double, milli>(extracted - built).count() << " ms"
+         << endl;
+
+    delete heap;
+}
+
+int main(int argc, char** argv) {
+    //Number of elements and the max number of threads
+    size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : 10000000;
+    unsigned int maxThreads = (argc > 2) ? atoi(argv[2]) : 32;
+
+    mt19937 rng(42);
+    vector<pair<int,int>> items(n);
+
+    for (size_t i = 0; i < n; i++) {
+        items[i] = make_pair((int)rng(), (int)i);
+    }
+
+    cout << "Parallel build of " << n << " elements on "
+         << thread::hardware_concurrency() << " hardware threads" << endl;
+    cout << setw(8) << "threads" << setw(14) << "consolidate"
+         << setw(15) << "build" << setw(15) << "extractMin" << endl;
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        run(items, threads, false);
+        run(items, threads, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "fibheap.h"
+using namespace std;
+
+//Pseudo random key of an element without storing the keys
+static inline int keyOf(unsigned long long i) {
+    i ^= i >> 33;
+    i *= 0xff51afd7ed558ccdULL;
+    i ^= i >> 33;
+    return (int)(i & 0x7fffffff);
+}
+
+static double seconds(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//Validates a single heap with more elements than a 32-bit counter can hold.
+//Every node of a FibonacciHeap<int,char> takes 40 bytes, so the default of
+//2^32 + 2^20 elements needs about 172 GB of memory.
+int main(int argc, char** argv) {
+    unsigned long long n = (argc > 1) ? strtoull(argv[1], NULL, 10) : (1ULL << 32) + (1ULL << 20);
+    const unsigned long long report = 1ULL << 28;
+
+    FibonacciHeap<int,char> heap;
+    vector<FibonacciHeap<int,char>::Handle> sample;
+
+    cout << "Inserting " << n << " elements" << endl;
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned long long i = 0; i < n; i++) {
+        FibonacciHeap<int,char>::Handle handle = heap.insert(keyOf(i), (char)(i & 0x7f));
+
+        //Some elements are moved to negative keys with their handles
+        if ((i & 0xfffff) == 0) {
+            sample.push_back(handle);
+        }
+
+        if ((i + 1) % report == 0) {
+            cout << "    " << i + 1 << " elements, " << heap.memoryUsage() / (1 << 20) << " MiB, "
+                 << fixed << setprecision(1) << seconds(start) << " s" << endl;
+        }
+    }
+
+    if (heap.size() != n) {
+        cerr << "Size " << heap.size() << " does not match " << n << endl;
+        return 1;
+    }
+
+    for (size_t i = 0; i < sample.size(); i++) {
+        heap.decreaseKey(sample[i], -1 - (int)i);
+    }
+
+    //The first extraction consolidates all roots into trees of high degree
+    cout << "Extracting all elements" << endl;
+    start = chrono::steady_clock::now();
+    int lastKey = heap.getMinKey();
+
+    if (lastKey != -(int)sample.size()) {
+        cerr << "Minimum key " << lastKey << " does not match the decreased keys" << endl;
+        return 1;
+    }
+
+    for (unsigned long long i = 0; i < n; i++) {
+        int key = heap.getMinKey();
+
+        if (key < lastKey || heap.isEmpty()) {
+            cerr << "Extraction " << i << " returned the key " << key << " after " << lastKey << endl;
+            return 1;
+        }
+
+        lastKey = key;
+        heap.extractMin();
+
+        if ((i + 1) % report == 0) {
+            cout << "    " << i + 1 << " elements, " << fixed << setprecision(1) << seconds(start) << " s" << endl;
+        }
+    }
+
+    if (!heap.isEmpty() || heap.size() != 0) {
+        cerr << "The heap is not empty after " << n << " extractions" << endl;
+        return 1;
+    }
+
+    cout << "Passed with " << n << " elements in " << fixed << setprecision(1) << seconds(start) << " s" << endl;
+    return 0;
+}
@@ -0,0 +1,221 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <chrono>
+#include <cstdlib>
+
+#include "scheduler.h"
+using namespace std;
+
+//Scheduler with a binary heap, a new priority inserts the task again and
+//the stale entry is skipped by its version
+class QueueScheduler final {
+    public:
+        struct Promise;
+        typedef coroutine_handle<Promise> Handle;
+
+        class QueueTask final {
+            public:
+                typedef Promise promise_type;
+                Handle coroutine;
+        };
+
+        struct Promise {
+            QueueScheduler* scheduler;
+            int priority;
+            uint64_t version;
+            bool ready;
+
+            QueueTask get_return_object() { return QueueTask{Handle::from_promise(*this)}; }
+            suspend_always initial_suspend() noexcept { return suspend_always(); }
+            suspend_always final_suspend() noexcept { return suspend_always(); }
+            void return_void() {}
+            void unhandled_exception() { terminate(); }
+        };
+
+        struct YieldAwaiter {
+            int priority;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(Handle coroutine) {
+                coroutine.promise().priority = priority;
+                coroutine.promise().scheduler->makeReady(coroutine);
+            }
+            void await_resume() const noexcept {}
+        };
+
+        struct SleepAwaiter {
+            long long deadline;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(Handle coroutine) {
+                coroutine.promise().scheduler->sleeping.push(make_pair(deadline, coroutine.address()));
+            }
+            void await_resume() const noexcept {}
+        };
+
+        typedef QueueTask TaskType;
+        typedef Handle TaskId;
+
+        QueueScheduler() : ticket(0), clock(0), tasks(0) {}
+
+        TaskId spawn(QueueTask task, int priority) {
+            task.coroutine.promise().scheduler = this;
+            task.coroutine.promise().priority = priority;
+            task.coroutine.promise().version = 0;
+            tasks++;
+            makeReady(task.coroutine);
+            return task.coroutine;
+        }
+
+        void setPriority(TaskId id, int priority) {
+            id.promise().priority = priority;
+
+            if (id.promise().ready) {
+                makeReady(id);
+            }
+        }
+
+        YieldAwaiter yieldTo(int priority) { return YieldAwaiter{priority}; }
+        SleepAwaiter sleepTo(long long deadline) { return SleepAwaiter{deadline}; }
+        long long now() const { return clock; }
+
+        void run() {
+            while (tasks > 0) {
+                while (!sleeping.empty() && sleeping.top().first <= clock) {
+                    makeReady(Handle::from_address(sleeping.top().second));
+                    sleeping.pop();
+                }
+
+                if (ready.empty()) {
+                    clock = sleeping.top().first;
+                    continue;
+                }
+
+                Handle coroutine = Handle::from_address(get<2>(ready.top()));
+                uint64_t version = get<1>(ready.top());
+                ready.pop();
+
+                if (version != coroutine.promise().version) {
+                    continue;
+                }
+
+                coroutine.promise().ready = false;
+                coroutine.resume();
+
+                if (coroutine.done()) {
+                    coroutine.destroy();
+                    tasks--;
+                }
+            }
+        }
+
+    private:
+        typedef tuple<long long,uint64_t,void*> Entry;
+
+        priority_queue<Entry, vector<Entry>, greater<Entry>> ready;
+        priority_queue<pair<long long,void*>, vector<pair<long long,void*>>, greater<pair<long long,void*>>> sleeping;
+        uint64_t ticket;
+        long long clock;
+        size_t tasks;
+
+        void makeReady(Handle coroutine) {
+            Promise& promise = coroutine.promise();
+            promise.version++;
+            promise.ready = true;
+            ready.push(Entry(((long long)promise.priority << 40) | (long long)ticket++, promise.version, coroutine.address()));
+        }
+};
+
+//The Fibonacci scheduler with the same interface as the baseline
+class HeapScheduler final {
+    public:
+        typedef Task TaskType;
+        typedef Scheduler::TaskId TaskId;
+
+        HeapScheduler() : scheduler(true) {}
+
+        TaskId spawn(Task task, int priority) { return scheduler.spawn(move(task), priority); }
+        void setPriority(TaskId id, int priority) { scheduler.setPriority(id, priority); }
+        YieldAwaiter yieldTo(int priority) { return yield(priority); }
+        SleepAwaiter sleepTo(long long deadline) { return sleepUntil(deadline); }
+        long long now() const { return scheduler.now(); }
+        void run() { scheduler.run(); }
+
+    private:
+        Scheduler scheduler;
+};
+
+//Yields with a random priority, every boost-th round a random task gets a
+//higher priority and every sleep-th round the task sleeps
+template <typename Runtime>
+typename Runtime::TaskType worker(Runtime& runtime, vector<typename Runtime::TaskId>& ids,
+                                  unsigned int seed, int rounds, int boost, int sleep) {
+    for (int i = 1; i <= rounds; i++) {
+        seed = seed * 1103515245 + 12345;
+
+        if (boost > 0 && i % boost == 0) {
+            runtime.setPriority(ids[(seed >> 8) % ids.size()], 0);
+        }
+
+        if (sleep > 0 && i % sleep == 0) {
+            co_await runtime.sleepTo(runtime.now() + (seed >> 16) % 1000);
+        } else {
+            co_await runtime.yieldTo(1 + (int)((seed >> 16) % 64));
+        }
+    }
+}
+
+template <typename Runtime>
+double measure(int taskCount, int rounds, int boost, int sleep) {
+    Runtime runtime;
+    vector<typename Runtime::TaskId> ids(taskCount);
+
+    auto start = chrono::steady_clock::now();
+
+    for (int t = 0; t < taskCount; t++) {
+        ids[t] = runtime.spawn(worker(runtime, ids, (unsigned int)t * 7919 + 1, rounds, boost, sleep), 1);
+    }
+
+    runtime.run();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return (double)taskCount * rounds / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int taskCount = (argc > 1) ? atoi(argv[1]) : 10000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 200;
+
+    struct Scenario {
+        const char* name;
+        int boost;
+        int sleep;
+    };
+
+    Scenario scenarios[] = {
+        {"yield", 0, 0},
+        {"yield + boost", 4, 0},
+        {"boost each round", 1, 0},
+        {"yield + sleep", 0, 4},
+    };
+
+    cout << taskCount << " tasks with " << rounds << " switches each, million switches per second" << endl;
+    cout << left << setw(18) << "" << right << setw(16) << "FibonacciHeap" << setw(16) << "priority_queue" << endl;
+
+    for (const Scenario& scenario : scenarios) {
+        double heap = measure<HeapScheduler>(taskCount, rounds, scenario.boost, scenario.sleep);
+        double queue = measure<QueueScheduler>(taskCount, rounds, scenario.boost, scenario.sleep);
+
+        cout << left << setw(18) << scenario.name << right << fixed << setprecision(2)
+             << setw(16) << heap << setw(16) << queue << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "fibheap.h"
+#include "softheap.h"
+using namespace std;
+
+//Bursts of inserts followed by extraction of half of the queue
+template <typename Heap>
+double run(Heap& heap, const vector<int>& keys) {
+    auto start = chrono::steady_clock::now();
+    unsigned int count = 0;
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        heap.insert(keys[i], (int)i);
+        count++;
+
+        if (i % 1000 == 999) {
+            for (unsigned int j = count / 2; j > 0; j--, count--) {
+                heap.extractMin();
+            }
+        }
+    }
+
+    while (!heap.isEmpty()) {
+        heap.extractMin();
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main() {
+    const unsigned int n = 2000000;
+    mt19937 rng(42);
+    vector<int> keys(n);
+
+    for (int& key : keys) {
+        key = (int)(rng() % n);
+    }
+
+    FibonacciHeap<int,int> fib;
+    double fibTime = run(fib, keys);
+
+    cout << "Insert/extract bursts with " << n << " elements" << endl;
+    cout << left << setw(24) << "FibonacciHeap" << right << setw(10)
+         << fixed << setprecision(2) << fibTime << " ms" << endl;
+
+    for (double epsilon : {0.5, 0.25, 0.1, 0.01, 0.001}) {
+        SoftHeap<int,int> soft(epsilon);
+        double softTime = run(soft, keys);
+
+        cout << left << "SoftHeap epsilon=" << setw(7) << setprecision(3) << epsilon
+             << right << setw(10) << setprecision(2) << softTime << " ms"
+             << "   corrupted extractions " << setprecision(4)
+             << soft.extractCorruptionRatio() << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <random>
+#include <iterator>
+#include <functional>
+
+#include "timerqueue.h"
+using namespace std;
+
+//Baseline with a binary heap and lazy deletion by a cancelled flag
+class PriorityQueueTimers {
+    private:
+        priority_queue<pair<long long,uint32_t>, vector<pair<long long,uint32_t>>, greater<pair<long long,uint32_t>>> heap;
+        vector<int> payloads;
+        vector<bool> cancelled;
+
+    public:
+        typedef uint32_t Token;
+
+        Token schedule(long long deadline, int payload) {
+            payloads.push_back(payload);
+            cancelled.push_back(false);
+            heap.push(make_pair(deadline, (uint32_t)(payloads.size() - 1)));
+            return (uint32_t)(payloads.size() - 1);
+        }
+
+        bool cancel(Token token) {
+            cancelled[token] = true;
+            return true;
+        }
+
+        template <typename OutputIt>
+        OutputIt popExpired(long long now, OutputIt out) {
+            while (!heap.empty() && heap.top().first <= now) {
+                if (!cancelled[heap.top().second]) {
+                    *out++ = make_pair(heap.top().first, payloads[heap.top().second]);
+                }
+
+                heap.pop();
+            }
+
+            return out;
+        }
+};
+
+//Every tick schedules new timers with a timeout and cancels most of them
+//before they expire, like the request timeouts of a network server
+template <typename Queue>
+double run(Queue& timers, unsigned int ticks, unsigned int perTick, unsigned int timeout, size_t& fired) {
+    typedef typename Queue::Token Token;
+    mt19937 rng(42);
+
+    //Cancellations are stored in a ring of ticks
+    vector<vector<Token>> cancels(timeout);
+    vector<pair<long long,int>> out;
+    fired = 0;
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned int now = 0; now < ticks; now++) {
+        for (unsigned int i = 0; i < perTick; i++) {
+            unsigned int delay = timeout / 2 + rng() % (timeout / 2);
+            Token token = timers.schedule(now + delay, (int)i);
+
+            if (rng() % 10 != 0) {
+                cancels[(now + 1 + rng() % (delay - 1)) % timeout].push_back(token);
+            }
+        }
+
+        for (Token token : cancels[now % timeout]) {
+            timers.cancel(token);
+        }
+
+        cancels[now % timeout].clear();
+        out.clear();
+        timers.popExpired(now, back_inserter(out));
+        fired += out.size();
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main() {
+    const unsigned int ticks = 20000;
+    const unsigned int timeout = 1000;
+
+    cout << "Timers with 90% cancellations over " << ticks << " ticks and a timeout of "
+         << timeout << " ticks" << endl;
+    cout << setw(10) << "per tick" << setw(18) << "priority_queue" << setw(15) << "exact"
+         << setw(15) << "bucketed" << setw(12) << "fired" << endl;
+
+    for (unsigned int perTick : {10, 100, 500}) {
+        size_t fired[3];
+        PriorityQueueTimers baseline;
+        TimerQueue<long long,int> exact;
+        TimerQueue<long long,int> bucketed(16);
+
+        double baselineTime = run(baseline, ticks, perTick, timeout, fired[0]);
+        double exactTime = run(exact, ticks, perTick, timeout, fired[1]);
+        double bucketedTime = run(bucketed, ticks, perTick, timeout, fired[2]);
+
+        cout << setw(10) << perTick << fixed << setprecision(1)
+             << setw(15) << baselineTime << " ms"
+             << setw(12) << exactTime << " ms"
+             << setw(12) << bucketedTime << " ms"
+             << setw(12) << fired[0] << endl;
+
+        if (fired[0] != fired[1]) {
+            cerr << "Fired timers differ: " << fired[0] << " and " << fired[1] << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
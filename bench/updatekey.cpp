@@ -0,0 +1,81 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "fibheap.h"
+using namespace std;
+
+enum Method { UPDATE_KEY, REMOVE_INSERT, REMOVE_VALUE_INSERT };
+
+//Priorities of random elements move up and down, every 16th step
+//extracts the minimum and inserts a new element
+double run(Method method, unsigned int n, unsigned int steps) {
+    mt19937 rng(42);
+    FibonacciHeap<int,int> heap;
+    vector<FibonacciHeap<int,int>::Handle> handles(n);
+
+    for (unsigned int i = 0; i < n; i++) {
+        handles[i] = heap.insert((int)(rng() % (1 << 24)), i);
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < steps; i++) {
+        unsigned int target = rng() % n;
+        int key = (int)(rng() % (1 << 24));
+
+        switch (method) {
+            case UPDATE_KEY:
+                heap.updateKey(handles[target], key);
+                break;
+
+            case REMOVE_INSERT:
+                heap.remove(handles[target]);
+                handles[target] = heap.insert(key, target);
+                break;
+
+            case REMOVE_VALUE_INSERT:
+                heap.remove((int)target);
+                handles[target] = heap.insert(key, target);
+                break;
+        }
+
+        if (i % 16 == 0) {
+            int value = heap.extractMin();
+            handles[value] = heap.insert(key, value);
+        }
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main() {
+    const unsigned int steps = 1000000;
+
+    cout << "Priority changes of random elements in " << steps << " steps" << endl;
+    cout << setw(10) << "elements" << setw(15) << "updateKey" << setw(20) << "remove+insert"
+         << setw(20) << "remove(value)" << endl;
+
+    for (unsigned int n : {1000, 100000, 1000000}) {
+        cout << setw(10) << n << fixed << setprecision(1)
+             << setw(12) << run(UPDATE_KEY, n, steps) << " ms"
+             << setw(17) << run(REMOVE_INSERT, n, steps) << " ms";
+
+        //The search for the value is linear
+        if (n <= 1000) {
+            cout << setw(17) << run(REMOVE_VALUE_INSERT, n, steps) << " ms";
+        }
+
+        cout << endl;
+    }
+
+    return 0;
+}
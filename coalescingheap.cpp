@@ -0,0 +1,248 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "coalescingheap.h"
+
+template <typename K, typename V>
+void CoalescingHeap<K,V>::makeHeap() {
+    heap = FibonacciHeap<K,uint32_t>();
+    buckets.clear();
+    freeBuckets.clear();
+    bucketIndex.clear();
+    valueCount = 0;
+}
+
+template <typename K, typename V>
+CoalescingHeap<K,V>::CoalescingHeap() {
+    valueCount = 0;
+}
+
+template <typename K, typename V>
+bool CoalescingHeap<K,V>::isEmpty() const {
+    return valueCount == 0;
+}
+
+template <typename K, typename V>
+size_t CoalescingHeap<K,V>::size() const {
+    return valueCount;
+}
+
+template <typename K, typename V>
+size_t CoalescingHeap<K,V>::keyCount() const {
+    return bucketIndex.size();
+}
+
+template <typename K, typename V>
+uint32_t CoalescingHeap<K,V>::bucketFor(K key) {
+    auto it = bucketIndex.find(key);
+
+    if (it != bucketIndex.end()) {
+        return it->second;
+    }
+
+    uint32_t bucket;
+
+    if (!freeBuckets.empty()) {
+        bucket = freeBuckets.back();
+        freeBuckets.pop_back();
+    } else {
+        buckets.push_back(Bucket());
+        bucket = (uint32_t)(buckets.size() - 1);
+    }
+
+    buckets[bucket].key = key;
+    buckets[bucket].head = 0;
+    bucketIndex[key] = bucket;
+    heap.insert(key, bucket);
+
+    return bucket;
+}
+
+template <typename K, typename V>
+void CoalescingHeap<K,V>::dropEmptyMin() {
+    //Buckets emptied by remove or decreaseKey stay in the heap until
+    //they become the minimum, so the minimum bucket is never empty
+    while (!heap.isEmpty()) {
+        uint32_t bucket = heap.getMin();
+        Bucket& minBucket = buckets[bucket];
+
+        if (minBucket.head < minBucket.values.size()) {
+            return;
+        }
+
+        heap.extractMin();
+        bucketIndex.erase(minBucket.key);
+        minBucket.values.clear();
+        freeBuckets.push_back(bucket);
+    }
+}
+
+template <typename K, typename V>
+void CoalescingHeap<K,V>::insert(K key, V value) {
+    buckets[bucketFor(key)].values.push_back(value);
+    valueCount++;
+}
+
+template <typename K, typename V>
+void CoalescingHeap<K,V>::meld(CoalescingHeap<K,V>* other) {
+    if (other == NULL || other == this || other->isEmpty()) {
+        return;
+    }
+
+    //Buckets are appended to the buckets of equal keys
+    for (Bucket& otherBucket : other->buckets) {
+        if (otherBucket.head < otherBucket.values.size()) {
+            Bucket& bucket = buckets[bucketFor(otherBucket.key)];
+
+            if (bucket.head == bucket.values.size()) {
+                bucket.values.clear();
+                bucket.head = 0;
+            }
+
+            bucket.values.insert(bucket.values.end(), otherBucket.values.begin() + otherBucket.head,
+                                 otherBucket.values.end());
+        }
+    }
+
+    valueCount += other->valueCount;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    //Reset the second heap to prevent unexpected side-effects
+    other->makeHeap();
+}
+
+template <typename K, typename V>
+V CoalescingHeap<K,V>::getMin() const {
+    if (isEmpty()) {
+        //Empty heap
+        return (V)0;
+    }
+
+    const Bucket& bucket = buckets[heap.getMin()];
+    return bucket.values[bucket.head];
+}
+
+template <typename K, typename V>
+K CoalescingHeap<K,V>::getMinKey() const {
+    return heap.getMinKey();
+}
+
+template <typename K, typename V>
+V CoalescingHeap<K,V>::extractMin() {
+    if (isEmpty()) {
+        //Empty heap
+        return (V)0;
+    }
+
+    //The forest is only changed when the bucket is drained
+    Bucket& bucket = buckets[heap.getMin()];
+    V minValue = bucket.values[bucket.head++];
+    valueCount--;
+
+    //Release the drained prefix once it is the larger part of a bucket
+    //that still has values, fewer values are moved than were extracted
+    if (bucket.head > bucket.values.size() / 2 && bucket.head < bucket.values.size()) {
+        bucket.values.erase(bucket.values.begin(), bucket.values.begin() + bucket.head);
+        bucket.head = 0;
+    }
+
+    dropEmptyMin();
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    return minValue;
+}
+
+template <typename K, typename V>
+bool CoalescingHeap<K,V>::find(V value, uint32_t& bucket, size_t& position) const {
+    for (uint32_t i = 0; i < buckets.size(); i++) {
+        for (size_t j = buckets[i].head; j < buckets[i].values.size(); j++) {
+            if (buckets[i].values[j] == value) {
+                bucket = i;
+                position = j;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+template <typename K, typename V>
+void CoalescingHeap<K,V>::erase(uint32_t bucket, size_t position) {
+    //Keep the insertion order of the remaining values, the shift is
+    //linear in the bucket size like the search of find
+    vector<V>& values = buckets[bucket].values;
+    values.erase(values.begin() + position);
+    valueCount--;
+}
+
+template <typename K, typename V>
+bool CoalescingHeap<K,V>::decreaseKey(V value, K newKey) {
+    uint32_t bucket;
+    size_t position;
+
+    //Check that the value exists and the new key is smaller
+    if (!find(value, bucket, position) || !(newKey < buckets[bucket].key)) {
+        return false;
+    }
+
+    erase(bucket, position);
+    insert(newKey, value);
+    dropEmptyMin();
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    return true;
+}
+
+template <typename K, typename V>
+bool CoalescingHeap<K,V>::remove(V value) {
+    uint32_t bucket;
+    size_t position;
+
+    if (!find(value, bucket, position)) {
+        return false;
+    }
+
+    erase(bucket, position);
+    dropEmptyMin();
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    return true;
+}
+
+#ifdef DEBUG
+template <typename K, typename V>
+bool CoalescingHeap<K,V>::invariant() {
+    size_t count = 0;
+    size_t nodes = 0;
+    bool invBuckets = true;
+
+    heap.forEach([&](K key, uint32_t bucket) {
+        //Every key has one bucket and the bucket has the key of its node
+        invBuckets &= buckets[bucket].key == key;
+        invBuckets &= bucketIndex.count(key) == 1 && bucketIndex[key] == bucket;
+        count += buckets[bucket].values.size() - buckets[bucket].head;
+        nodes++;
+    });
+
+    bool invMin = heap.isEmpty() || buckets[heap.getMin()].head < buckets[heap.getMin()].values.size();
+    return invBuckets && invMin && count == valueCount && nodes == bucketIndex.size();
+}
+#endif
+
+template class CoalescingHeap<int,char>;
+template class CoalescingHeap<int,int>;
@@ -0,0 +1,76 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include "fibheap.h"
+
+#ifdef DEBUG
+#include <assert.h>
+#endif
+
+using namespace std;
+
+#ifndef COALESCINGHEAP_H
+#define COALESCINGHEAP_H
+
+//Heap for workloads with many equal keys. All values of a key share one
+//node of the Fibonacci heap and are stored in a bucket, so an insert of a
+//known key is an append and extractMin drains the bucket before the forest
+//is changed. Values of the same key are extracted in insertion order.
+//The values are not indexed, so decreaseKey and remove search all buckets
+//and close the gap in the bucket of the value in O(n) time.
+template <typename K, typename V>
+class CoalescingHeap final {
+    private:
+        struct Bucket {
+            K key;
+            vector<V> values;
+
+            //Index of the first value that was not extracted
+            size_t head;
+        };
+
+        //Every node of the heap holds the index of a bucket
+        FibonacciHeap<K,uint32_t> heap;
+
+        vector<Bucket> buckets;
+        vector<uint32_t> freeBuckets;
+        unordered_map<K,uint32_t> bucketIndex;
+
+        size_t valueCount;
+
+        inline void makeHeap();
+        uint32_t bucketFor(K key);
+        void dropEmptyMin();
+        bool find(V value, uint32_t& bucket, size_t& position) const;
+        void erase(uint32_t bucket, size_t position);
+
+    public:
+        CoalescingHeap();
+
+        bool isEmpty() const;
+        size_t size() const;
+        size_t keyCount() const;
+
+        void insert(K key, V value);
+        void meld(CoalescingHeap<K,V>* other);
+
+        V getMin() const;
+        K getMinKey() const;
+        V extractMin();
+
+        bool decreaseKey(V value, K newKey);
+        bool remove(V value);
+
+        #ifdef DEBUG
+        bool invariant();
+        #endif
+
+};
+
+#endif /* COALESCINGHEAP_H */
@@ -0,0 +1,276 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstddef>
+
+#ifndef FIBCORE_H
+#define FIBCORE_H
+
+//Pointer links of the nodes in the FibonacciHeap
+template <typename Node>
+struct FibonacciPointerLinks {
+    typedef Node* Ref;
+
+    static Ref nil() { return NULL; }
+    Node& at(Ref ref) const { return *ref; }
+};
+
+//Index links into the node array of the StaticFibonacciHeap
+template <typename Node, typename Index, Index Nil>
+struct FibonacciIndexLinks {
+    typedef Index Ref;
+    Node* nodes;
+
+    static Ref nil() { return Nil; }
+    Node& at(Ref ref) const { return nodes[ref]; }
+};
+
+//Table of the consolidation without a copy of the root keys
+struct FibonacciNoMirror {
+    template <typename K>
+    void set(unsigned int, const K&) {}
+    void clear(unsigned int) {}
+};
+
+//Algorithms shared by the heaps on pointer and on index links, so both
+//heaps build the same trees. The nodes have the fields prev, next, child,
+//parent, key, marked and degree. The links policy maps a reference to
+//its node and provides the reference used instead of NULL.
+template <typename Links>
+struct FibonacciCore {
+    typedef typename Links::Ref Ref;
+
+    //Append a single node to the end of the rootlist
+    static void appendNode(const Links& links, Ref& rootlist, Ref node) {
+        if (rootlist == Links::nil()) {
+            rootlist = node;
+            links.at(node).prev = links.at(node).next = node;
+            return;
+        }
+
+        Ref lastNode = links.at(rootlist).prev;
+
+        links.at(lastNode).next = node;
+        links.at(rootlist).prev = node;
+        links.at(node).prev = lastNode;
+        links.at(node).next = rootlist;
+    }
+
+    //Concatenate a circular list with the end of the rootlist
+    static void spliceList(const Links& links, Ref& rootlist, Ref list) {
+        if (rootlist == Links::nil()) {
+            rootlist = list;
+            return;
+        }
+
+        Ref lastNode = links.at(rootlist).prev;
+        Ref listLastNode = links.at(list).prev;
+
+        links.at(lastNode).next = list;
+        links.at(list).prev = lastNode;
+        links.at(listLastNode).next = rootlist;
+        links.at(rootlist).prev = listLastNode;
+    }
+
+    //Move all children of a node to the rootlist as unmarked roots
+    static void promoteChildren(const Links& links, Ref& rootlist, Ref node) {
+        Ref child = links.at(node).child;
+
+        if (child == Links::nil()) {
+            return;
+        }
+
+        Ref curNode = child;
+
+        do {
+            links.at(curNode).parent = Links::nil();
+            links.at(curNode).marked = false;
+            curNode = links.at(curNode).next;
+        } while (curNode != child);
+
+        spliceList(links, rootlist, child);
+        links.at(node).child = Links::nil();
+        links.at(node).degree = 0;
+    }
+
+    //Unlink a root and move its children to the rootlist
+    static void removeRoot(const Links& links, Ref& rootlist, Ref node) {
+        links.at(links.at(node).next).prev = links.at(node).prev;
+        links.at(links.at(node).prev).next = links.at(node).next;
+
+        if (rootlist == node) {
+            rootlist = (links.at(node).next == node) ? Links::nil() : links.at(node).next;
+        }
+
+        promoteChildren(links, rootlist, node);
+    }
+
+    //Make the root with the larger key a child of the other root
+    static Ref link(const Links& links, Ref a, Ref b) {
+        //Make sure that a is the smaller node
+        if (links.at(a).key > links.at(b).key) {
+            Ref swap = a;
+            a = b;
+            b = swap;
+        }
+
+        //Links to b can be ignored because they will be overwritten
+        //by the rootlist reconstruction during consolidation
+        links.at(a).degree++;
+        links.at(a).marked = false;
+        links.at(b).marked = false;
+
+        //Move b to the childlist of a
+        links.at(b).parent = a;
+        Ref child = links.at(a).child;
+
+        if (child == Links::nil()) {
+            links.at(b).prev = links.at(b).next = b;
+            links.at(a).child = b;
+
+        } else {
+            //Set b between the child of a and the last node
+            links.at(b).prev = links.at(child).prev;
+            links.at(b).next = child;
+
+            links.at(links.at(child).prev).next = b;
+            links.at(child).prev = b;
+        }
+
+        return a;
+    }
+
+    //Move a node with its subtree from its parent to the rootlist
+    static void cut(const Links& links, Ref& rootlist, Ref node) {
+        Ref parent = links.at(node).parent;
+
+        if (parent == Links::nil()) {
+            return;
+        }
+
+        links.at(parent).degree--;
+
+        //Update the child link of the parent
+        if (links.at(parent).degree == 0) {
+            links.at(parent).child = Links::nil();
+        } else {
+            links.at(parent).child = links.at(node).next;
+        }
+
+        //Nodes in the rootlist have no parent and are unmarked
+        links.at(node).parent = Links::nil();
+        links.at(node).marked = false;
+
+        //Remove the node from its list
+        links.at(links.at(node).next).prev = links.at(node).prev;
+        links.at(links.at(node).prev).next = links.at(node).next;
+
+        appendNode(links, rootlist, node);
+    }
+
+    //Cut the node and all marked ancestors, returns the last reached node
+    static Ref cascadingCut(const Links& links, Ref& rootlist, Ref node) {
+        do {
+            Ref oldParent = links.at(node).parent;
+            cut(links, rootlist, node);
+            node = oldParent;
+
+        } while (links.at(node).marked && links.at(node).parent != Links::nil());
+
+        //Mark the child lost
+        if (links.at(node).parent != Links::nil()) {
+            links.at(node).marked = true;
+        }
+
+        return node;
+    }
+
+    //Link the roots with equal degrees into a table of trees indexed by
+    //degree. The mirror is told about every change of the table.
+    template <typename Mirror>
+    static void linkRoots(const Links& links, Ref rootlist, Ref* trees, unsigned int maxTrees, Mirror& mirror) {
+        for (unsigned int i = 0; i < maxTrees; i++) {
+            trees[i] = Links::nil();
+        }
+
+        Ref curNode = rootlist;
+
+        do {
+            Ref node = curNode;
+            curNode = links.at(curNode).next;
+
+            while (trees[links.at(node).degree] != Links::nil()) {
+                unsigned int prevDegree = links.at(node).degree;
+                node = link(links, trees[prevDegree], node);
+
+                trees[prevDegree] = Links::nil();
+                mirror.clear(prevDegree);
+            }
+
+            trees[links.at(node).degree] = node;
+            mirror.set(links.at(node).degree, links.at(node).key);
+
+        } while (curNode != rootlist);
+    }
+
+    //Chain the trees of the table to the new rootlist in degree order.
+    //Returns the first tree with the smallest key when findMin is set.
+    static Ref rebuildRoots(const Links& links, Ref& rootlist, const Ref* trees,
+                            unsigned int maxTrees, bool findMin) {
+        Ref min = Links::nil();
+        rootlist = Links::nil();
+
+        for (unsigned int i = 0; i < maxTrees; i++) {
+            if (trees[i] != Links::nil()) {
+                appendNode(links, rootlist, trees[i]);
+
+                if (findMin && (min == Links::nil() || links.at(trees[i]).key < links.at(min).key)) {
+                    min = trees[i];
+                }
+            }
+        }
+
+        return min;
+    }
+
+    //Preorder visit of all nodes without a stack, the parent links lead
+    //back from a completed child list. The visitor must not change links.
+    template <typename Visitor>
+    static void forEachNode(const Links& links, Ref rootlist, Visitor visit) {
+        if (rootlist == Links::nil()) {
+            return;
+        }
+
+        Ref node = rootlist;
+
+        while (true) {
+            visit(node);
+
+            if (links.at(node).child != Links::nil()) {
+                node = links.at(node).child;
+                continue;
+            }
+
+            //Continue with the next sibling of the node or of an ancestor
+            while (true) {
+                Ref parent = links.at(node).parent;
+                Ref first = (parent == Links::nil()) ? rootlist : links.at(parent).child;
+
+                if (links.at(node).next != first) {
+                    node = links.at(node).next;
+                    break;
+                }
+
+                if (parent == Links::nil()) {
+                    return;
+                }
+
+                node = parent;
+            }
+        }
+    }
+};
+
+#endif /* FIBCORE_H */
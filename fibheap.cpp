@@ -3,109 +3,344 @@
 // Copyright (c) 2018 Henrik Peters
 // See LICENSE file in the project root for full license information.
 // ---------------------------------------------------------------------
+#include <atomic>
 #include "fibheap.h"
+#include "payload.h"
+
+//Shared by all heaps because the debug checks must not change the heap layout
+static atomic<unsigned int> invariantInterval(1);
+static atomic<unsigned long> invariantCounter(0);
+
+void setInvariantSampling(unsigned int interval) {
+    invariantInterval = interval;
+}
+
+unsigned int getInvariantSampling() {
+    return invariantInterval;
+}
 
 template <typename K, typename V>
 void FibonacciHeap<K,V>::makeHeap() {
     rootlist = NULL;
     min = NULL;
     nodeCount = 0;
+    offset = (K)0;
+    maxStored = numeric_limits<K>::lowest();
+    pending = false;
 }
 
 template <typename K, typename V>
 FibonacciHeap<K,V>::FibonacciHeap() {
     makeHeap();
+    lazy = false;
+    vectorMin = false;
 }
 
 template <typename K, typename V>
 FibonacciHeap<K,V>::FibonacciHeap(const FibonacciHeap<K,V>& orig) {
     makeHeap();
+    lazy = orig.lazy;
+    vectorMin = orig.vectorMin;
+    offset = orig.offset;
+    maxStored = orig.maxStored;
 
     if (!orig.isEmpty()) {
-        insertList(orig.rootlist);
+        cloneFrom(orig);
     }
 }
 
+template <typename K, typename V>
+FibonacciHeap<K,V>::FibonacciHeap(FibonacciHeap<K,V>&& orig) {
+    makeHeap();
+    lazy = orig.lazy;
+    vectorMin = orig.vectorMin;
+    offset = orig.offset;
+    maxStored = orig.maxStored;
+
+    //Take over the nodes and a shared forest in O(1)
+    rootlist = orig.rootlist;
+    min = orig.min;
+    nodeCount = orig.nodeCount;
+    pending = orig.pending;
+    arena.merge(&orig.arena);
+    values.merge(&orig.values);
+    frozen = move(orig.frozen);
+
+    orig.makeHeap();
+}
+
 template <typename K, typename V>
 FibonacciHeap<K,V>& FibonacciHeap<K,V>::operator=(const FibonacciHeap<K,V>& rhs) {
-    //Free the current nodes
-    if (!isEmpty()) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    //Free the current nodes unless they are shared
+    if (frozen) {
+        frozen.reset();
+        makeHeap();
+
+    } else if (!isEmpty()) {
         freeList(rootlist);
 
         //Set the current heap to the empty state
         makeHeap();
     }
 
+    offset = rhs.offset;
+    maxStored = rhs.maxStored;
+
     if (!rhs.isEmpty()) {
-        insertList(rhs.rootlist);
+        cloneFrom(rhs);
     }
 
     return *this;
 }
 
+template <typename K, typename V>
+FibonacciHeap<K,V>& FibonacciHeap<K,V>::operator=(FibonacciHeap<K,V>&& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    //Free the current nodes unless they are shared
+    if (frozen) {
+        frozen.reset();
+    } else if (!isEmpty()) {
+        freeList(rootlist);
+    }
+
+    makeHeap();
+    lazy = rhs.lazy;
+    vectorMin = rhs.vectorMin;
+    offset = rhs.offset;
+    maxStored = rhs.maxStored;
+
+    //Take over the nodes and a shared forest in O(1)
+    rootlist = rhs.rootlist;
+    min = rhs.min;
+    nodeCount = rhs.nodeCount;
+    pending = rhs.pending;
+    arena.merge(&rhs.arena);
+    values.merge(&rhs.values);
+    frozen = move(rhs.frozen);
+
+    rhs.makeHeap();
+    return *this;
+}
+
 template <typename K, typename V>
 FibonacciHeap<K,V>::~FibonacciHeap() {
-    if (!isEmpty()) {
+    //Trivial nodes and values are released together with the arenas
+    //and shared nodes together with the last holder of the frozen heap
+    if (!isEmpty() && !frozen && !(is_trivially_destructible<Node>::value && is_trivially_destructible<V>::value)) {
         freeList(rootlist);
     }
 }
 
 template <typename K, typename V>
 void FibonacciHeap<K,V>::freeList(Node* node) {
-    Node* iterateNode = node->next;
+    //The links of each node are saved by the traversal before it is released
+    traverse(node, [this](Node* curNode, size_t) {
+        releaseNode(curNode);
+        return true;
+    });
+}
 
-    do {
-        Node* curNode = iterateNode;
-        iterateNode = iterateNode->next;
+template <typename K, typename V>
+void FibonacciHeap<K,V>::releaseNode(Node* node) {
+    node->value.release(values);
+    node->~Node();
+    arena.release(node);
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::isEmpty() const {
+    return rootlist == NULL;
+}
 
-        //Recursive list freeing
-        if (curNode->child != NULL) {
-            freeList(curNode->child);
+template <typename K, typename V>
+void FibonacciHeap<K,V>::cloneFrom(const FibonacciHeap<K,V>& source) {
+    //Clone of the last node on every level of the current path
+    vector<Node*> path;
+
+    //Copy the forest with its shape, both heaps have the same offset
+    source.traverse(source.rootlist, [&](Node* node, size_t depth) {
+        Node* clone = new (arena.allocate()) Node;
+        clone->key = node->key;
+        clone->value.store(node->value.get(), values);
+        clone->marked = node->marked;
+        clone->degree = node->degree;
+        clone->child = NULL;
+        clone->parent = (depth > 0) ? path[depth - 1] : NULL;
+
+        bool firstNode = (depth > 0) ? node == node->parent->child : node == source.rootlist;
+
+        if (firstNode) {
+            //Start a new rootlist or child list
+            clone->prev = clone->next = clone;
+
+            if (depth > 0) {
+                clone->parent->child = clone;
+            } else {
+                rootlist = clone;
+            }
+
+        } else {
+            //Append the clone after its previous sibling
+            Node* head = (depth > 0) ? clone->parent->child : rootlist;
+            clone->prev = head->prev;
+            clone->next = head;
+            head->prev->next = clone;
+            head->prev = clone;
         }
 
-        //Prevent double freeing of lists with 1 element
-        if (curNode != node) {
-            delete curNode;
+        if (node == source.min) {
+            min = clone;
         }
 
-    } while (iterateNode != node);
+        path.resize(depth);
+        path.push_back(clone);
+        return true;
+    });
+
+    nodeCount = source.nodeCount;
+    pending = source.pending;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+}
 
-    //Free the first element
-    delete node;
+template <typename K, typename V>
+void FibonacciHeap<K,V>::detach() {
+    //Shared nodes are never changed
+    if (frozen) {
+        detachShared();
+    }
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::isEmpty() const {
-    return rootlist == NULL;
+void FibonacciHeap<K,V>::detachShared() {
+    shared_ptr<FibonacciHeap<K,V>> shared = move(frozen);
+
+    if (shared.use_count() == 1) {
+        //All snapshots are released, take the nodes back in O(1). The count
+        //is read relaxed, the fence orders the reads of a snapshot released
+        //on another thread before the release of its count and our changes.
+        atomic_thread_fence(memory_order_acquire);
+
+        arena.merge(&shared->arena);
+        values.merge(&shared->values);
+        shared->rootlist = NULL;
+        shared->min = NULL;
+        shared->nodeCount = 0;
+
+    } else {
+        //The snapshots keep the shared nodes and this heap gets a copy
+        rootlist = NULL;
+        min = NULL;
+        cloneFrom(*shared);
+    }
 }
 
 template <typename K, typename V>
-void FibonacciHeap<K,V>::insertList(Node* node) {
-    Node* curNode = node;
+FibonacciHeap<K,V> FibonacciHeap<K,V>::snapshot() {
+    //A shared forest never has a pending consolidation
+    restoreMin();
 
-    do {
-        insert(curNode->key, curNode->value);
+    FibonacciHeap<K,V> copy;
+    copy.lazy = lazy;
+    copy.vectorMin = vectorMin;
+    copy.offset = offset;
+    copy.maxStored = maxStored;
 
-        //Recursive list insertion
-        if (curNode->child != NULL) {
-            insertList(curNode->child);
+    if (!isEmpty()) {
+        if (!frozen) {
+            //Move the nodes to a frozen heap that is shared by all holders
+            frozen = make_shared<FibonacciHeap<K,V>>();
+            frozen->rootlist = rootlist;
+            frozen->min = min;
+            frozen->nodeCount = nodeCount;
+            frozen->arena.merge(&arena);
+            frozen->values.merge(&values);
         }
 
-        curNode = curNode->next;
-    } while (curNode != node);
+        copy.frozen = frozen;
+        copy.rootlist = rootlist;
+        copy.min = min;
+        copy.nodeCount = nodeCount;
+    }
+
+    return copy;
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::isShared() const {
+    return (bool)frozen;
+}
+
+template <typename K, typename V>
+size_t FibonacciHeap<K,V>::sharedBytes() const {
+    return frozen ? frozen->arena.bytes() + frozen->values.bytes() : 0;
+}
+
+template <typename K, typename V>
+size_t FibonacciHeap<K,V>::size() const {
+    return nodeCount;
+}
+
+template <typename K, typename V>
+size_t FibonacciHeap<K,V>::memoryUsage() const {
+    return sizeof(*this) + arena.bytes() + values.bytes();
 }
 
 template <typename K, typename V>
-void FibonacciHeap<K,V>::insert(K key, V value) {
-    Node* node = new Node;
+void FibonacciHeap<K,V>::compact() {
+    //Clone the forest into a single slab, the preorder keeps every
+    //child list next to its parent
+    FibonacciHeap<K,V> compacted;
+    compacted.offset = offset;
+
+    if (!isEmpty()) {
+        compacted.arena.reserve(nodeCount);
+        compacted.values.reserve(nodeCount);
+        compacted.cloneFrom(*this);
+
+        if (frozen) {
+            //Shared nodes are cloned once without a detach, the last
+            //holder of the frozen heap releases them
+            frozen.reset();
+        } else if (!(is_trivially_destructible<Node>::value && is_trivially_destructible<V>::value)) {
+            freeList(rootlist);
+        }
+    }
+
+    //Release the old slabs and take over the compacted nodes
+    arena.clear();
+    values.clear();
+    rootlist = compacted.rootlist;
+    min = compacted.min;
+    pending = compacted.pending;
+    arena.merge(&compacted.arena);
+    values.merge(&compacted.values);
+
+    compacted.makeHeap();
+}
+
+template <typename K, typename V>
+typename FibonacciHeap<K,V>::Handle FibonacciHeap<K,V>::insert(K key, V value) {
+    detach();
+    Node* node = new (arena.allocate()) Node;
 
     //Initialize the node values
     node->prev = node;
     node->next = node;
     node->child = NULL;
     node->parent = NULL;
-    node->key = key;
-    node->value = value;
+    node->key = toStored(key);
+    maxStored = max(maxStored, node->key);
+    node->value.store(value, values);
     node->degree = 0;
     node->marked = false;
     
@@ -113,20 +348,283 @@ void FibonacciHeap<K,V>::insert(K key, V value) {
     meldNode(node);
 
     #ifdef DEBUG
-    assert (invariant());
+    assert (invariantSampled({node, min}));
+    #endif
+
+    return Handle(node);
+}
+
+template <typename K, typename V>
+void FibonacciHeap<K,V>::insertParallel(const pair<K,V>* items, size_t count,
+                                        unsigned int threads, bool consolidateTrees) {
+    detach();
+
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    //Small inputs are not worth the thread creation
+    if (threads == 1 || count < 2 * (size_t)threads) {
+        for (size_t i = 0; i < count; i++) {
+            insert(items[i].first, items[i].second);
+        }
+
+        if (consolidateTrees) {
+            consolidate();
+        }
+
+        return;
+    }
+
+    //Every thread builds a heap with its own arena
+    vector<FibonacciHeap<K,V>> parts(threads);
+    vector<thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+
+    for (unsigned int t = 0; t < threads; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        FibonacciHeap<K,V>* part = &parts[t];
+        part->offset = offset;
+
+        workers.push_back(thread([part, items, begin, end, consolidateTrees]() {
+            for (size_t i = begin; i < end; i++) {
+                part->insert(items[i].first, items[i].second);
+            }
+
+            //Link the roots in parallel instead of in the first extractMin
+            if (consolidateTrees) {
+                part->consolidate();
+            }
+        }));
+    }
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    //Splice the rootlists and arenas in O(threads)
+    for (FibonacciHeap<K,V>& part : parts) {
+        meld(&part);
+    }
+}
+
+template <typename K, typename V>
+void FibonacciHeap<K,V>::applyBatch(const Operation* ops, size_t count, vector<Result>& results) {
+    detach();
+    results.resize(count);
+    size_t begin = 0;
+
+    while (begin < count) {
+        //Inserts and decreases up to the next operation that needs the minimum
+        size_t end = begin;
+
+        while (end < count && (ops[end].type == INSERT || ops[end].type == DECREASE_KEY)) {
+            end++;
+        }
+
+        applySegment(ops, begin, end, results);
+
+        if (end < count) {
+            if (ops[end].type == EXTRACT_MIN) {
+                results[end].success = !isEmpty();
+                results[end].value = extractMin();
+            } else {
+                results[end].success = remove(ops[end].value);
+                results[end].value = ops[end].value;
+            }
+
+            end++;
+        }
+
+        begin = end;
+    }
+}
+
+template <typename K, typename V>
+void FibonacciHeap<K,V>::applySegment(const Operation* ops, size_t begin, size_t end, vector<Result>& results) {
+    //A single rebase lets all keys of the segment be stored relative to the offset
+    for (size_t i = begin; i < end; i++) {
+        if (!KeyMath::canSubtract(ops[i].key, offset)) {
+            rebase((K)0);
+            break;
+        }
+    }
+
+    //Decreases sorted by value and operation index
+    vector<pair<V,size_t>> targets;
+    vector<Node*> inserted;
+    vector<size_t> insertedOps;
+
+    for (size_t i = begin; i < end; i++) {
+        if (ops[i].type == DECREASE_KEY) {
+            targets.push_back(make_pair(ops[i].value, i));
+        }
+    }
+
+    stable_sort(targets.begin(), targets.end(), [](const pair<V,size_t>& a, const pair<V,size_t>& b) {
+        return a.first < b.first;
+    });
+
+    //Find the targets that already exist with a single traversal
+    vector<Node*> found(targets.size(), (Node*)NULL);
+
+    if (!targets.empty() && !isEmpty()) {
+        findAll(rootlist, targets, found);
+    }
+
+    //Create the inserted nodes as a separate list
+    Node* insertList = NULL;
+    Node* insertMin = NULL;
+
+    for (size_t i = begin; i < end; i++) {
+        if (ops[i].type == INSERT) {
+            Node* node = new (arena.allocate()) Node;
+
+            node->child = NULL;
+            node->parent = NULL;
+            node->key = ops[i].key - offset;
+            maxStored = max(maxStored, node->key);
+            node->value.store(ops[i].value, values);
+            node->degree = 0;
+            node->marked = false;
+
+            if (insertList == NULL) {
+                insertList = insertMin = node;
+                node->prev = node->next = node;
+            } else {
+                node->prev = insertList->prev;
+                node->next = insertList;
+                insertList->prev->next = node;
+                insertList->prev = node;
+
+                if (node->key < insertMin->key) {
+                    insertMin = node;
+                }
+            }
+
+            inserted.push_back(node);
+            insertedOps.push_back(i);
+            results[i].success = true;
+            results[i].value = ops[i].value;
+        }
+    }
+
+    //Splice all inserted nodes into the rootlist at once
+    if (insertList != NULL) {
+        if (rootlist == NULL) {
+            rootlist = insertList;
+            min = insertMin;
+        } else {
+            Node* lastNode = rootlist->prev;
+            Node* insertLastNode = insertList->prev;
+
+            lastNode->next = insertList;
+            insertList->prev = lastNode;
+            insertLastNode->next = rootlist;
+            rootlist->prev = insertLastNode;
+
+            if (insertMin->key < min->key) {
+                min = insertMin;
+            }
+        }
+
+        nodeCount += inserted.size();
+    }
+
+    //Inserted nodes sorted by value and operation index
+    vector<size_t> insertedValues(inserted.size());
+    iota(insertedValues.begin(), insertedValues.end(), 0);
+
+    stable_sort(insertedValues.begin(), insertedValues.end(), [&](size_t a, size_t b) {
+        return ops[insertedOps[a]].value < ops[insertedOps[b]].value;
+    });
+
+    //Apply the decreases in operation order of each value
+    for (size_t t = 0; t < targets.size(); t++) {
+        size_t i = targets[t].second;
+        Node* node = found[t];
+
+        //The first node with this value inserted before the decrease
+        if (node == NULL) {
+            auto it = lower_bound(insertedValues.begin(), insertedValues.end(), ops[i].value,
+                [&](size_t k, const V& value) {
+                    return ops[insertedOps[k]].value < value;
+                });
+
+            if (it != insertedValues.end() && ops[insertedOps[*it]].value == ops[i].value && insertedOps[*it] < i) {
+                node = inserted[*it];
+            }
+        }
+
+        results[i].value = ops[i].value;
+        results[i].success = node != NULL && ops[i].key - offset < node->key;
+
+        if (results[i].success) {
+            decreaseNode(node, ops[i].key - offset);
+        }
+    }
+
+    #ifdef DEBUG
+    assert (isEmpty() || invariantSampled({rootlist, rootlist->prev, min}));
     #endif
 }
 
+template <typename K, typename V>
+void FibonacciHeap<K,V>::findAll(Node* list, const vector<pair<V,size_t>>& targets, vector<Node*>& found) const {
+    traverse(list, [&](Node* curNode, size_t) {
+        //Binary search for the decreases of this value
+        auto it = lower_bound(targets.begin(), targets.end(), curNode->value.get(),
+            [](const pair<V,size_t>& target, const V& value) {
+                return target.first < value;
+            });
+
+        //The first node in traversal order is the same as with find
+        for (; it != targets.end() && it->first == curNode->value.get(); ++it) {
+            if (found[it - targets.begin()] == NULL) {
+                found[it - targets.begin()] = curNode;
+            }
+        }
+
+        return true;
+    });
+}
+
 template <typename K, typename V>
 void FibonacciHeap<K,V>::meld(FibonacciHeap<K,V>* other) {
     //There is no change when merging with an empty rootlist
-    if (rootlist != NULL && other != NULL) {
+    if (other != NULL && other != this && !other->isEmpty()) {
+        detach();
+        other->detach();
+
+        //The stored keys of the other heap must use the same offset.
+        //Both heaps fall back to the zero offset when a key does not fit.
+        if (other->offset != offset) {
+            if (!fitsOffset(other->rootlist, other->offset - offset)) {
+                rebase((K)0);
+            }
+
+            other->rebase(offset);
+        }
 
-        //Meld with the root node of the other rootlist
-        meldNode(other->rootlist);
+        maxStored = max(maxStored, other->maxStored);
+
+        //Concatenate both circular rootlists and update the min pointer
+        if (rootlist == NULL || other->min->key < min->key) {
+            min = other->min;
+        }
+
+        Core::spliceList(Links(), rootlist, other->rootlist);
+
+        nodeCount += other->nodeCount;
+        pending = pending || other->pending;
+
+        //The nodes of the other heap are now owned by this heap
+        arena.merge(&other->arena);
+        values.merge(&other->values);
 
         #ifdef DEBUG
-        assert (invariant());
+        assert (invariantSampled({rootlist, rootlist->prev, other->rootlist, other->rootlist->prev, min}));
         #endif
 
         //Reset the secound rootlist to prevent unexpected side-effects
@@ -134,6 +632,7 @@ void FibonacciHeap<K,V>::meld(FibonacciHeap<K,V>* other) {
         other->rootlist = NULL;
         other->min = NULL;
         other->nodeCount = 0;
+        other->pending = false;
     }
 }
 
@@ -147,7 +646,7 @@ void FibonacciHeap<K,V>::meldNode(Node* node) {
     } else if (node != NULL) {
 
         //Append the node to the rootlist
-        appendNode(node);
+        Core::appendNode(Links(), rootlist, node);
 
         //Update the min pointer
         if (node->key < min->key) {
@@ -159,283 +658,681 @@ void FibonacciHeap<K,V>::meldNode(Node* node) {
 }
 
 template <typename K, typename V>
-void FibonacciHeap<K,V>::appendNode(Node* node) {
-    //Save the pointer to the old last node
-    Node* lastNode = rootlist->prev;
+void FibonacciHeap<K,V>::setLazy(bool lazy) {
+    this->lazy = lazy;
+
+    //Leave the lazy mode with a valid min pointer
+    if (!lazy) {
+        restoreMin();
+    }
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::isLazy() const {
+    return lazy;
+}
 
-    //Set the pointers to the new node
-    lastNode->next = node;
-    rootlist->prev = node;
+template <typename K, typename V>
+void FibonacciHeap<K,V>::setVectorMin(bool vectorMin) {
+    //Only numeric keys can be padded with the max key
+    this->vectorMin = vectorMin && numeric_limits<K>::is_specialized;
+}
 
-    //Set the pointers from the new node
-    node->prev = lastNode;
-    node->next = rootlist;
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::isVectorMin() const {
+    return vectorMin;
+}
+
+template <typename K, typename V>
+void FibonacciHeap<K,V>::restoreMin() const {
+    //The deferred consolidation changes the rootlist but not the contents
+    if (pending) {
+        consolidate();
+    }
 }
 
 template <typename K, typename V>
 V FibonacciHeap<K,V>::getMin() const {
+    restoreMin();
+
     if (min == NULL) {
         //Empty rootlist
         return (V)0;
     } else {
-        return min->value;
+        return min->value.get();
     }
 }
 
 template <typename K, typename V>
-V FibonacciHeap<K,V>::extractMin() {
+K FibonacciHeap<K,V>::getMinKey() const {
+    restoreMin();
+
     if (min == NULL) {
         //Empty rootlist
-        return (V)0;
+        return (K)0;
     } else {
-        //Save values of the min node
-        V minValue = min->value;
-        Node* minChild = min->child;
+        return toKey(min->key);
+    }
+}
 
-        //Remove the min node from the list
-        min->next->prev = min->prev;
-        min->prev->next = min->next;
+template <typename K, typename V>
+void FibonacciHeap<K,V>::peekNodes(size_t k, vector<const Node*>& nodes) const {
+    if (isEmpty() || k == 0) {
+        return;
+    }
 
-        //Update the rootlist pointer
-        if (rootlist == min) {
-            rootlist = (min->next == min)
-                ? NULL
-                : min->next;
-        }
+    //Min-heap of candidate nodes ordered by their keys
+    auto greaterKey = [](const Node* a, const Node* b) {
+        return b->key < a->key;
+    };
 
-        delete min;
-        nodeCount--;
+    //Every root is a candidate, the forest is not linked because the
+    //heap is only read and may be read by several threads
+    vector<const Node*> candidates;
+    const Node* curNode = rootlist;
 
-        if (minChild != NULL) {
-            //Add all childs of the minimum to the rootlist
-            Node* curNode = minChild;
+    do {
+        candidates.push_back(curNode);
+        curNode = curNode->next;
+    } while (curNode != rootlist);
+
+    make_heap(candidates.begin(), candidates.end(), greaterKey);
+
+    //The children of a node can only follow after the node itself
+    while (nodes.size() < k && !candidates.empty()) {
+        pop_heap(candidates.begin(), candidates.end(), greaterKey);
+        const Node* node = candidates.back();
+        candidates.pop_back();
+        nodes.push_back(node);
+
+        if (node->child != NULL) {
+            const Node* child = node->child;
 
             do {
-                curNode->marked = false;
-                curNode->parent = NULL;
+                candidates.push_back(child);
+                push_heap(candidates.begin(), candidates.end(), greaterKey);
+                child = child->next;
+            } while (child != node->child);
+        }
+    }
+}
 
-                //In order not to break the iteration during node appending
-                //save the current node and move the iteration to the next node
-                Node* node = curNode;
-                curNode = curNode->next;
+template <typename K, typename V>
+V FibonacciHeap<K,V>::extractMin() {
+    detach();
+    restoreMin();
 
-                //Add the node to the rootlist
-                if (rootlist == NULL) {
-                    rootlist = node;
-                    rootlist->next = rootlist;
-                    rootlist->prev = rootlist;
-                } else {
-                    appendNode(node);
-                }
+    if (min == NULL) {
+        //Empty rootlist
+        return (V)0;
+    } else {
+        //Remove the min node and add all its childs to the rootlist
+        V minValue = min->value.get();
+        Core::removeRoot(Links(), rootlist, min);
 
-            } while (curNode != minChild);
+        releaseNode(min);
+        nodeCount--;
+
+        if (lazy) {
+            //Defer the consolidation until the minimum is observed
+            min = rootlist;
+            pending = (rootlist != NULL);
+        } else {
+            consolidate();
         }
 
-        consolidate();
         return minValue;
     }
 }
 
+//Table of the consolidation that copies the root keys for the vector search
+template <typename K>
+struct FibonacciKeyMirror {
+    K* keys;
+
+    void set(unsigned int degree, const K& key) { keys[degree] = key; }
+    void clear(unsigned int degree) { keys[degree] = numeric_limits<K>::max(); }
+};
+
 template <typename K, typename V>
-void FibonacciHeap<K,V>::consolidate() {
+void FibonacciHeap<K,V>::consolidate() const {
+    pending = false;
+
     //Empty heap or single node
     if (nodeCount <= 1) {
         min = rootlist;
         return;
     }
 
-    unsigned int maxTrees = 2 * log2(nodeCount);
-    Node* trees[maxTrees] = {NULL};
+    //The degree table is sized for the largest possible heap
+    //but only the entries up to the current bound are used
+    unsigned int maxTrees = fibheapMaxDegree(nodeCount) + 1;
+    Node* trees[fibheapMaxDegree(~0ULL) + 1];
 
-    Node* curNode = rootlist;
+    if (!vectorMin) {
+        //Link rootlist nodes with the same degree and compare the new roots
+        FibonacciNoMirror noMirror;
+        Core::linkRoots(Links(), rootlist, trees, maxTrees, noMirror);
+        min = Core::rebuildRoots(Links(), rootlist, trees, maxTrees, true);
 
-    //Link rootlist nodes with the same degree
-    do {
-        Node* node = curNode;
-        curNode = curNode->next;
+    } else {
+        //Contiguous mirror of the root keys indexed by degree, kept up to
+        //date by the linking. Missing trees and the padding get the max key.
+        const unsigned int keyCount = (maxTrees + SIMDMIN_LANES - 1) / SIMDMIN_LANES * SIMDMIN_LANES;
+        alignas(SIMDMIN_ALIGN) K rootKeys[(fibheapMaxDegree(~0ULL) + SIMDMIN_LANES) / SIMDMIN_LANES * SIMDMIN_LANES];
+        fill(rootKeys, rootKeys + keyCount, numeric_limits<K>::max());
+
+        FibonacciKeyMirror<K> mirror = {rootKeys};
+        Core::linkRoots(Links(), rootlist, trees, maxTrees, mirror);
+        Core::rebuildRoots(Links(), rootlist, trees, maxTrees, false);
+
+        //Vectorized search in the mirror and the first tree with the min key
+        K minKeyValue = minKey(rootKeys, keyCount);
+        unsigned int i = 0;
+
+        while (trees[i] == NULL || minKeyValue < rootKeys[i]) {
+            i++;
+        }
 
-        while (trees[node->degree] != NULL) {
-            int prevDegree = node->degree;
-            node = link(trees[node->degree], node);
+        min = trees[i];
+    }
 
-            trees[prevDegree] = NULL;
-        }
+    #ifdef DEBUG
+    assert (invariantRoots());
+    assert (normalized(rootlist));
+    #endif
+}
 
-        trees[node->degree] = node;
-        
-    } while (curNode != rootlist);
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::decreaseKey(V value, K newKey) {
+    detach();
+    Node* node = isEmpty() ? NULL : find(rootlist, value);
 
-    //Create the new rootlist
-    rootlist = NULL;
+    //Check that the node exists and the new key is smaller
+    if (node && toStored(newKey) < node->key) {
+        decreaseNode(node, toStored(newKey));
+        return true;
+    } else {
+        return false;
+    }
+}
 
-    for (unsigned int i = 0; i < maxTrees; i++) {
-        if (trees[i] != NULL) {
+template <typename K, typename V>
+void FibonacciHeap<K,V>::decreaseNode(Node* node, K newKey) {
+    #ifdef DEBUG
+    Node* decreased = node;
+    #endif
 
-            //First node for the new rootlist
-            if (rootlist == NULL) {
-                rootlist = min = trees[i];
-                rootlist->prev = rootlist->next = rootlist;
-            }
+    node->key = newKey;
 
-            //Append the node to the rootlist
-            appendNode(trees[i]);
+    //Update the min pointer, a pending consolidation finds the min itself
+    if (!pending && node->key < min->key) {
+        min = node;
+    }
 
-            //Update the minimum pointer
-            if (trees[i]->key < min->key) {
-                min = trees[i];
-            }
+    //Done when the node is in the rootlist or the parent still has a lower key
+    if (node->parent != NULL && node->parent->key > newKey) {
+        //Repair the heap order
+        node = Core::cascadingCut(Links(), rootlist, node);
+    }
+
+    #ifdef DEBUG
+    //The last cut node is the last node of the rootlist
+    assert (invariantSampled({decreased, node, rootlist->prev, min}));
+    #endif
+}
+
+template <typename K, typename V>
+void FibonacciHeap<K,V>::increaseNode(Node* node, K newKey) {
+    node->key = newKey;
+    maxStored = max(maxStored, newKey);
+
+    //Children may have smaller keys now, so all of them become roots
+    Core::promoteChildren(Links(), rootlist, node);
+
+    //The parent lost a child of a high degree, so the node is cut as well
+    if (node->parent != NULL) {
+        Core::cascadingCut(Links(), rootlist, node);
+    }
+
+    //A new minimum can be any root
+    if (node == min) {
+        if (lazy) {
+            min = rootlist;
+            pending = true;
+        } else {
+            consolidate();
         }
     }
 
     #ifdef DEBUG
-    assert (invariant());
-    assert (normalized(rootlist));
+    assert (invariantSampled({node, rootlist->prev, min}));
     #endif
 }
 
 template <typename K, typename V>
-typename FibonacciHeap<K,V>::Node* FibonacciHeap<K,V>::link(Node* a, Node* b) {
+typename FibonacciHeap<K,V>::Node* FibonacciHeap<K,V>::find(Node* list, V value) const {
+    Node* foundNode = NULL;
+
+    //Stop the traversal at the first match
+    traverse(list, [&](Node* curNode, size_t) {
+        if (curNode->value.get() == value) {
+            foundNode = curNode;
+            return false;
+        }
+
+        return true;
+    });
+
+    return foundNode;
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::remove(V value) {
+    detach();
+    Node* node = isEmpty() ? NULL : find(rootlist, value);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    removeNode(node);
+    return true;
+}
+
+template <typename K, typename V>
+void FibonacciHeap<K,V>::removeNode(Node* node) {
+    bool wasMin = (node == min);
+
+    //Move the node to the rootlist like a decrease, the key is not changed,
+    //so no key below the minimum is needed
+    if (node->parent != NULL) {
+        Core::cascadingCut(Links(), rootlist, node);
+    }
+
+    Core::removeRoot(Links(), rootlist, node);
+    releaseNode(node);
+    nodeCount--;
+
+    //The children have larger keys, so only the removal of the min needs a search
+    if (wasMin) {
+        if (lazy) {
+            min = rootlist;
+            pending = (rootlist != NULL);
+        } else {
+            consolidate();
+        }
+    }
+
     #ifdef DEBUG
-    //When linking two nodes they have the same degree
-    assert (a->degree == b->degree);
+    assert (isEmpty() || invariantSampled({rootlist, rootlist->prev, min}));
     #endif
+}
+
+template <typename K, typename V>
+K FibonacciHeap<K,V>::getKey(Handle handle) const {
+    return toKey(handle.node->key);
+}
+
+template <typename K, typename V>
+V FibonacciHeap<K,V>::getValue(Handle handle) const {
+    return handle.node->value.get();
+}
 
-    //Make sure that a is the smaller node
-    if (a->key > b->key) {
-        Node* swap = a;
-        a = b;
-        b = swap;
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::decreaseKey(Handle handle, K newKey) {
+    //The node is known, so no search is needed
+    if (handle.node == NULL) {
+        return false;
     }
 
-    //Pointers to b can be ignored because they will be overwritten
-    //by the rootlist reconstruction during consolidation
-    a->degree++;
-    a->marked = false;
+    detach();
+    K storedKey = toStored(newKey);
 
-    //Move b to the childlist of a
-    b->parent = a;
+    if (!(storedKey < handle.node->key)) {
+        return false;
+    }
 
-    if (a->child == NULL) {
-        b->prev = b->next = b;
-        a->child = b;
+    decreaseNode(handle.node, storedKey);
+    return true;
+}
 
-    } else {
-        //Set b between the child of a and the last node
-        b->prev = a->child->prev;
-        b->next = a->child;
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::updateKey(Handle handle, K newKey) {
+    if (handle.node == NULL) {
+        return false;
+    }
+
+    detach();
+    K storedKey = toStored(newKey);
 
-        //Update the next pointer of the last node
-        b->prev->next = b;
-        a->child->prev = b;
+    if (storedKey < handle.node->key) {
+        decreaseNode(handle.node, storedKey);
+    } else if (handle.node->key < storedKey) {
+        increaseNode(handle.node, storedKey);
     }
 
-    return a;
+    return true;
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::decreaseKey(V value, K newKey) {
-    Node* node = find(rootlist, value);
+bool FibonacciHeap<K,V>::remove(Handle handle) {
+    if (handle.node == NULL) {
+        return false;
+    }
 
-    //Check that the node exists and the new key is smaller
-    if (node && newKey < node->key) {
-        node->key = newKey;
+    detach();
+    removeNode(handle.node);
+    return true;
+}
 
-        //Update the min pointer
-        if (node->key < min->key) {
-            min = node;
-        }
+template <typename K, typename V>
+size_t FibonacciHeap<K,V>::extractUpTo(K maxKey, vector<pair<K,V>>& out) {
+    detach();
+    restoreMin();
 
-        //Done when the node is in the rootlist or the parent still has a lower key
-        if (node->parent != NULL && node->parent->key > newKey) {
-            //Repair the heap order
+    if (isEmpty()) {
+        return 0;
+    }
 
-            do {
-                //Cascading node cuts
-                Node* oldParent = node->parent;
-                cut(node);
-                node = oldParent;
+    const K bound = toStored(maxKey);
 
-            } while (node->marked && node->parent != NULL);
+    if (bound < min->key) {
+        return 0;
+    }
 
-            //Mark the child lost
-            if (node->parent != NULL) {
-                node->marked = true;
-            }
+    vector<Node*> extracted;
+    vector<Node*> roots;
+    Node* curNode = rootlist;
+
+    //Roots up to the bound are extracted, the others stay in the rootlist
+    do {
+        (curNode->key <= bound ? extracted : roots).push_back(curNode);
+        curNode = curNode->next;
+    } while (curNode != rootlist);
+
+    //Children of extracted nodes are extracted as well or become roots.
+    //The heap order stops the search below the first larger key.
+    for (size_t i = 0; i < extracted.size(); i++) {
+        Node* child = extracted[i]->child;
+
+        if (child != NULL) {
+            curNode = child;
+
+            do {
+                if (curNode->key <= bound) {
+                    extracted.push_back(curNode);
+                } else {
+                    curNode->parent = NULL;
+                    curNode->marked = false;
+                    roots.push_back(curNode);
+                }
+
+                curNode = curNode->next;
+            } while (curNode != child);
         }
+    }
 
-        #ifdef DEBUG
-        assert (invariant());
-        #endif
+    //Link the remaining roots to the new rootlist
+    rootlist = NULL;
 
-        return true;
+    for (Node* root : roots) {
+        Core::appendNode(Links(), rootlist, root);
+    }
+
+    min = rootlist;
+
+    size_t first = out.size();
+
+    for (Node* node : extracted) {
+        out.push_back(make_pair(toKey(node->key), node->value.get()));
+        releaseNode(node);
+    }
+
+    nodeCount -= extracted.size();
+
+    //Ascending order of the extracted elements
+    stable_sort(out.begin() + first, out.end(), [](const pair<K,V>& a, const pair<K,V>& b) {
+        return a.first < b.first;
+    });
+
+    //A single consolidation for all extracted elements
+    if (lazy) {
+        min = rootlist;
+        pending = (rootlist != NULL);
     } else {
+        consolidate();
+    }
+
+    return extracted.size();
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::shiftAllKeys(K delta) {
+    //Keys beyond the range would be clamped by the folding and become ties
+    if (!shiftFits(delta)) {
         return false;
     }
+
+    //The order of the keys does not change. The offset stays within a
+    //quarter of the key range, so new keys can be stored relative to it.
+    const K offsetLimit = numeric_limits<K>::max() / 4;
+
+    if (delta <= offsetLimit && delta >= -offsetLimit &&
+        offset + delta <= offsetLimit && offset + delta >= -offsetLimit) {
+        offset += delta;
+        return true;
+    }
+
+    //Fold the offset into the stored keys before it can overflow
+    detach();
+    rebase((K)0);
+
+    if (delta <= offsetLimit && delta >= -offsetLimit) {
+        offset = delta;
+    } else if (!isEmpty()) {
+        rebaseList(rootlist, delta);
+        maxStored += delta;
+    }
+
+    return true;
 }
 
 template <typename K, typename V>
-void FibonacciHeap<K,V>::cut(Node* node) {
-    if (node->parent != NULL) {
-        //Move node to the rootlist
-        node->parent->degree--;
+bool FibonacciHeap<K,V>::shiftFits(K delta) {
+    if (isEmpty()) {
+        maxStored = numeric_limits<K>::lowest();
+        return true;
+    }
 
-        //Update the child pointer
-        if (node->parent->degree == 0) {
-            node->parent->child = NULL;
-        } else {
-            node->parent->child = node->next;
-        }
+    //All keys are in the range, so the smallest and the largest key are checked
+    restoreMin();
+
+    if (!KeyMath::canAdd(min->key + offset, delta)) {
+        return false;
+    }
 
-        //Nodes in the rootlist have no parent
-        node->parent = NULL;
+    if (KeyMath::canAdd(KeyMath::saturatedAdd(maxStored, offset), delta)) {
+        return true;
+    }
 
-        //Remove node from its list
-        node->next->prev = node->prev;
-        node->prev->next = node->next;
+    //The bound may belong to an extracted key, so the largest key is searched
+    K largest = min->key;
+    traverse(rootlist, [&largest](Node* node, size_t) {
+        largest = max(largest, node->key);
+        return true;
+    });
 
-        //Insert the node into the rootlist
-        appendNode(node);
+    maxStored = largest;
+    return KeyMath::canAdd(largest + offset, delta);
+}
+
+template <typename K, typename V>
+K FibonacciHeap<K,V>::toStored(K key) {
+    //Keys that can not be stored relative to the offset fold it first
+    if (!KeyMath::canSubtract(key, offset)) {
+        rebase((K)0);
     }
+
+    return key - offset;
 }
 
 template <typename K, typename V>
-typename FibonacciHeap<K,V>::Node* FibonacciHeap<K,V>::find(Node* list, V value) const {
-    Node* curNode = list;
+void FibonacciHeap<K,V>::rebase(K newOffset) {
+    if (!isEmpty()) {
+        rebaseList(rootlist, offset - newOffset);
+        maxStored = KeyMath::saturatedAdd(maxStored, offset - newOffset);
+    }
 
-    do {
-        if (curNode->value == value) {
-            return curNode;
-        }
+    offset = newOffset;
+}
 
-        //Recursive search for the child lists
-        if (curNode->child != NULL) {
-            Node* childSearch = find(curNode->child, value);
+//The shifts keep all keys in the range of K, the saturation only guards
+//against a rebase that could not be represented
+template <typename K, typename V>
+void FibonacciHeap<K,V>::rebaseList(Node* node, K delta) {
+    traverse(node, [delta](Node* curNode, size_t) {
+        curNode->key = KeyMath::saturatedAdd(curNode->key, delta);
+        return true;
+    });
+}
 
-            if (childSearch) {
-                return childSearch;
-            }
-        }
+//Check that all stored keys of the list can be moved by the delta
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::fitsOffset(Node* list, K delta) const {
+    return traverse(list, [delta](Node* curNode, size_t) {
+        return KeyMath::canSubtract(curNode->key, -delta);
+    });
+}
 
-        curNode = curNode->next;
-    } while (curNode != list);
+//Character values are exported as numbers
+template <typename T>
+static inline void exportField(ostream& out, const T& field) {
+    out << field;
+}
 
-    return NULL;
+static inline void exportField(ostream& out, char field) {
+    out << (int)field;
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::remove(V value) {
-    //Decrease the key of the target node to become the new min node
-    if (decreaseKey(value, min->key - (K)1)) {
-        extractMin();
+size_t FibonacciHeap<K,V>::exportStructure(ostream& out, ExportFormat format,
+                                           const ExportOptions& options) const {
+    //Identifiers of the last exported node on every level of the current path
+    vector<size_t> path;
+    size_t exported = 0;
+
+    switch (format) {
+        case EXPORT_DOT:
+            out << "digraph heap {\n" << "node [shape=record];\n";
+            break;
+        case EXPORT_JSON:
+            out << "{\"offset\":";
+            exportField(out, offset);
+            out << ",\"fields\":[\"id\",\"parent\",\"depth\",\"key\",\"value\",\"degree\",\"marked\",\"min\"]";
+            out << ",\"nodes\":[";
+            break;
+        case EXPORT_CSV:
+            out << "id,parent,depth,key,value,degree,marked,min\n";
+            break;
+    }
+
+    //Every node is written once in preorder, the parent was written before
+    auto exportNode = [&](Node* node, size_t depth) {
+        if (exported >= options.maxNodes) {
+            return false;
+        }
+
+        size_t id = exported++;
+        path.resize(depth);
+        path.push_back(id);
+
+        switch (format) {
+            case EXPORT_DOT:
+                out << "n" << id << " [label=\"{";
+                exportField(out, toKey(node->key));
+                out << "|";
+                exportField(out, node->value.get());
+                out << "}|" << (int)node->degree << "\"";
+
+                if (node == min) {
+                    out << ", style=filled, fillcolor=\"0.650 0.200 1.000\"";
+                } else if (node->marked) {
+                    out << ", style=filled, fillcolor=\"#EEC591\"";
+                }
+
+                out << "];\n";
+
+                if (depth > 0) {
+                    out << "n" << path[depth - 1] << " -> n" << id << ";\n";
+                }
+                break;
+
+            case EXPORT_JSON:
+            case EXPORT_CSV:
+                //Both formats use the same fields, JSON as a compact array
+                if (format == EXPORT_JSON) {
+                    out << (id > 0 ? ",[" : "[");
+                }
+
+                out << id << ',';
+
+                if (depth > 0) {
+                    out << path[depth - 1];
+                } else {
+                    out << -1;
+                }
+
+                out << ',' << depth << ',';
+                exportField(out, toKey(node->key));
+                out << ',';
+                exportField(out, node->value.get());
+                out << ',' << (int)node->degree << ',' << (int)node->marked << ',' << (int)(node == min);
+                out << (format == EXPORT_JSON ? "]" : "\n");
+                break;
+        }
+
         return true;
+    };
+
+    if (!isEmpty()) {
+        Node* root = rootlist;
+        size_t index = 0;
+        bool complete = true;
+
+        do {
+            //Trees of the sample are exported with their child lists
+            if (index++ % max(options.treeStride, (size_t)1) == 0) {
+                complete = exportNode(root, 0);
+
+                if (complete && root->child != NULL && options.maxDepth > 0) {
+                    complete = traverse(root->child, [&](Node* node, size_t depth) {
+                        return exportNode(node, depth + 1);
+                    }, options.maxDepth - 1);
+                }
+            }
+
+            root = root->next;
+        } while (complete && root != rootlist);
     }
 
-    return false;
+    switch (format) {
+        case EXPORT_DOT:
+            out << "}\n";
+            break;
+        case EXPORT_JSON:
+            out << "]}\n";
+            break;
+        case EXPORT_CSV:
+            break;
+    }
+
+    return exported;
 }
 
 #ifdef DEBUG
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::invariant() {
+bool FibonacciHeap<K,V>::invariant() const {
     if (isEmpty()) {
         return rootlist == NULL && min == NULL && nodeCount == 0;
 
@@ -449,32 +1346,69 @@ bool FibonacciHeap<K,V>::invariant() {
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::invariantList(Node* node) {
-    Node* curNode = node;
+bool FibonacciHeap<K,V>::invariantSampled(initializer_list<Node*> touched) const {
     bool invNodes = true;
 
-    do {
-        invNodes &= invariantNode(curNode);
-
-        //Recursive descent for trees
-        if (curNode->child != NULL) {
-            invNodes &= invariantList(curNode->child);
+    //Local checks of the touched nodes and their parents
+    for (Node* node : touched) {
+        if (node != NULL) {
+            invNodes &= invariantNode(node);
+            invNodes &= node->parent == NULL || invariantNode(node->parent);
         }
+    }
 
-        curNode = curNode->next;
-    } while (curNode != node);
+    //The min pointer is a root
+    invNodes &= isEmpty() || (min != NULL && min->parent == NULL);
+
+    unsigned int interval = invariantInterval;
+
+    if (interval > 0 && invariantCounter++ % interval == 0) {
+        invNodes &= invariant();
+    }
+
+    return invNodes;
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::invariantRoots() const {
+    bool invRoots = true;
+
+    //After the consolidation the roots are the only touched nodes
+    if (!isEmpty()) {
+        Node* curNode = rootlist;
+
+        do {
+            invRoots &= curNode->parent == NULL && invariantNode(curNode);
+            curNode = curNode->next;
+        } while (curNode != rootlist);
+    }
+
+    return invariantSampled({min}) && invRoots;
+}
+
+template <typename K, typename V>
+bool FibonacciHeap<K,V>::invariantList(Node* node) const {
+    bool invNodes = true;
+
+    traverse(node, [&](Node* curNode, size_t) {
+        invNodes &= invariantNode(curNode);
+        return true;
+    });
 
     return invNodes;
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::invariantNode(Node* node) {
+bool FibonacciHeap<K,V>::invariantNode(Node* node) const {
     //All nodes below have a higher order
     bool heapOrder = (node->child == NULL) || invariantHeapOrder(node->child, node->key);
     bool invDegree = (node->child == NULL) || invariantDegree(node);
 
-    //The min pointer has the lowest key
-    bool minOrder = (node == min) || (min->key <= node->key);
+    //The min pointer has the lowest key unless the consolidation is pending
+    bool minOrder = (node == min) || pending || (min->key <= node->key);
+
+    //The parent has a lower key
+    bool parentOrder = (node->parent == NULL) || !(node->key < node->parent->key);
 
     //Chaining of the list
     bool prevChain = node->next->prev == node;
@@ -493,24 +1427,18 @@ bool FibonacciHeap<K,V>::invariantNode(Node* node) {
         } while (curNode != node->child);
     }
     
-    return heapOrder && invDegree && minOrder && prevChain &&
+    return heapOrder && parentOrder && invDegree && minOrder && prevChain &&
            nextChain && childChain && childListChain;
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::invariantHeapOrder(Node* node, K key) {
+bool FibonacciHeap<K,V>::invariantHeapOrder(Node* node, K key) const {
     Node* curNode = node;
     bool heapOrder = true;
 
+    //Deeper levels are covered by the check of every child list
     do {
-        if (curNode->key < key) {
-            heapOrder = false;
-        }
-
-        if (curNode->child != NULL) {
-            heapOrder &= invariantHeapOrder(curNode->child, key);
-        }
-
+        heapOrder &= !(curNode->key < key);
         curNode = curNode->next;
     } while (curNode != node);
 
@@ -518,7 +1446,7 @@ bool FibonacciHeap<K,V>::invariantHeapOrder(Node* node, K key) {
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::invariantDegree(Node* node) {
+bool FibonacciHeap<K,V>::invariantDegree(Node* node) const {
     Node* curNode = node->child;
     unsigned int listCount = 0;
 
@@ -531,25 +1459,19 @@ bool FibonacciHeap<K,V>::invariantDegree(Node* node) {
 }
 
 template <typename K, typename V>
-unsigned int FibonacciHeap<K,V>::invariantNodeCount(Node* node) {
-    unsigned int nodeSum = 0;
-    Node* curNode = node;
+size_t FibonacciHeap<K,V>::invariantNodeCount(Node* node) const {
+    size_t nodeSum = 0;
 
-    do {
+    traverse(node, [&](Node*, size_t) {
         nodeSum++;
-
-        if (curNode->child != NULL) {
-            nodeSum += invariantNodeCount(curNode->child);
-        }
-
-        curNode = curNode->next;
-    } while (curNode != node);
+        return true;
+    });
 
     return nodeSum;
 }
 
 template <typename K, typename V>
-bool FibonacciHeap<K,V>::normalized(Node* node) {
+bool FibonacciHeap<K,V>::normalized(Node* node) const {
     map<unsigned int,unsigned int> nodeMap;
     bool uniqueDegrees = true;
     Node* curNode = node;
@@ -633,7 +1555,7 @@ void FibonacciHeap<K,V>::dump(string dumpName) {
             graphFile << node->key << " [shape=record,";
         }
 
-        graphFile << "label=\"{{" << node->key << "|" << node->value << "}|" << node->degree << "}\"];" << endl;
+        graphFile << "label=\"{{" << node->key << "|" << node->value.get() << "}|" << (int)node->degree << "}\"];" << endl;
     }
 
     //Add the rank footer
@@ -660,19 +1582,19 @@ void FibonacciHeap<K,V>::dump(string dumpName) {
 
 template <typename K, typename V>
 void FibonacciHeap<K,V>::dumpNode(list<pair<Node*,int>>* nodeList, Node* node, int depth) {
-    Node* curNode = node;
-
-    do {
-        nodeList->push_back(make_pair(curNode, depth));
-
-        if (curNode->child != NULL) {
-            dumpNode(nodeList, curNode->child, depth + 1);
-        }
-
-        curNode = curNode->next;
-    } while (curNode != node);
+    traverse(node, [&](Node* curNode, size_t level) {
+        nodeList->push_back(make_pair(curNode, depth + (int)level));
+        return true;
+    });
 }
 #endif
 
 template class FibonacciHeap<int,char>;
 template class FibonacciHeap<int,int>;
+template class FibonacciHeap<int,unsigned int>;
+template class FibonacciHeap<long long,unsigned int>;
+template class FibonacciHeap<long long,void*>;
+template class FibonacciHeap<int,Payload<64,false>>;
+template class FibonacciHeap<int,Payload<64,true>>;
+template class FibonacciHeap<int,Payload<256,false>>;
+template class FibonacciHeap<int,Payload<256,true>>;
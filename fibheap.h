@@ -4,8 +4,22 @@
 // See LICENSE file in the project root for full license information.
 // ---------------------------------------------------------------------
 #include <iostream>
+#include <cstdint>
 #include <cmath>
 #include <cstdlib>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+#include <memory>
+#include <atomic>
+#include "simdmin.h"
+#include "arena.h"
+#include "fibcore.h"
 
 #ifdef DEBUG
 #include <assert.h>
@@ -20,60 +34,377 @@ using namespace std;
 #ifndef FIBHEAP_H
 #define FIBHEAP_H
 
+//Upper bound for the degree of any node in a heap with n nodes.
+//A node with degree d roots a subtree of at least F(d+2) nodes.
+constexpr unsigned int fibheapMaxDegree(unsigned long long n) {
+    unsigned long long prev = 1;
+    unsigned long long cur = 2;
+    unsigned int degree = 0;
+
+    while (cur <= n) {
+        degree++;
+
+        //Stop before the next fibonacci number overflows
+        if (prev > ~0ULL - cur) {
+            break;
+        }
+
+        unsigned long long next = prev + cur;
+        prev = cur;
+        cur = next;
+    }
+
+    return degree;
+}
+
+//Debug builds check the nodes touched by an operation and run the full
+//invariant check on every n-th operation of all heaps. Zero disables the
+//full checks, the default of one checks the whole heap after every operation.
+void setInvariantSampling(unsigned int interval);
+unsigned int getInvariantSampling();
+
+//Values above the size of two pointers are stored apart from the nodes in
+//their own arena. The consolidation, link and cut then only touch the small
+//nodes with the keys and links. A specialization selects the layout of a type.
+template <typename V>
+struct FibonacciValueLayout {
+    static const bool cold = sizeof(V) > 2 * sizeof(void*);
+};
+
+//Value stored inside the node, no extra storage is needed
+template <typename V, bool Cold = FibonacciValueLayout<V>::cold>
+struct FibonacciNodeValue {
+    struct Storage {
+        void reserve(size_t) {}
+        void merge(Storage*) {}
+        void clear() {}
+        size_t bytes() const { return 0; }
+    };
+
+    V value;
+
+    void store(const V& newValue, Storage&) { value = newValue; }
+    void release(Storage&) {}
+    V& get() { return value; }
+    const V& get() const { return value; }
+};
+
+//Pointer to a value in the cold storage
+template <typename V>
+struct FibonacciNodeValue<V,true> {
+    typedef NodeArena<V> Storage;
+
+    V* value;
+
+    void store(const V& newValue, Storage& storage) { value = new (storage.allocate()) V(newValue); }
+    void release(Storage& storage) { value->~V(); storage.release(value); }
+    V& get() { return *value; }
+    const V& get() const { return *value; }
+};
+
+//Translation between stored keys and keys with the offset of shiftAllKeys.
+//Signed integers check the range, other key types can not overflow here.
+template <typename K, bool Checked = numeric_limits<K>::is_integer && numeric_limits<K>::is_signed>
+struct FibonacciKeyMath {
+    static bool canAdd(K, K) { return true; }
+    static bool canSubtract(K, K) { return true; }
+    static K saturatedAdd(K a, K b) { return a + b; }
+};
+
+template <typename K>
+struct FibonacciKeyMath<K,true> {
+    static bool canAdd(K a, K b) {
+        return (b > 0) ? a <= numeric_limits<K>::max() - b : a >= numeric_limits<K>::min() - b;
+    }
+
+    static bool canSubtract(K a, K b) {
+        return (b < 0) ? a <= numeric_limits<K>::max() + b : a >= numeric_limits<K>::min() + b;
+    }
+
+    static K saturatedAdd(K a, K b) {
+        if (b > 0 && a > numeric_limits<K>::max() - b) {
+            return numeric_limits<K>::max();
+        } else if (b < 0 && a < numeric_limits<K>::min() - b) {
+            return numeric_limits<K>::min();
+        }
+
+        return a + b;
+    }
+};
+
 template <typename K, typename V>
 class FibonacciHeap final {
     private:
         struct Node {
             Node *prev, *next, *child, *parent;
             K key;
-            V value;
             bool marked;
-            unsigned int degree;
-        } *rootlist, *min;
 
-        unsigned int nodeCount;
+            //The degree of a heap with 2^64 nodes is below 100
+            uint8_t degree;
+
+            //Inline value or a pointer to the cold value
+            FibonacciNodeValue<V> value;
+        };
+
+        //The rootlist and the min pointer are changed by the deferred
+        //consolidation of a const observer, the elements stay the same
+        mutable Node *rootlist, *min;
+
+        //The tree algorithms are shared with the StaticFibonacciHeap
+        typedef FibonacciPointerLinks<Node> Links;
+        typedef FibonacciCore<Links> Core;
+        typedef FibonacciKeyMath<K> KeyMath;
+
+        size_t nodeCount;
+
+        //Heap-wide shift that is added to all stored keys on read
+        K offset;
+
+        //Upper bound of the stored keys for the range check of a shift,
+        //extractions and decreases leave it unchanged
+        K maxStored;
+
+        //Storage of all nodes in this heap and of their cold values
+        NodeArena<Node> arena;
+        typename FibonacciNodeValue<V>::Storage values;
+
+        //Forest shared with snapshots, the nodes are owned by the frozen heap
+        shared_ptr<FibonacciHeap<K,V>> frozen;
+
+        //Lazy mode and a consolidation that was deferred by extractMin
+        bool lazy;
+        mutable bool pending;
+
+        //Vectorized minimum search over a copy of the root keys
+        bool vectorMin;
 
         inline void makeHeap();
-        void insertList(Node* node);
+        void cloneFrom(const FibonacciHeap<K,V>& source);
+        inline void detach();
+        void detachShared();
         void freeList(Node* node);
+        inline void releaseNode(Node* node);
+        void rebaseList(Node* node, K delta);
+        void rebase(K newOffset);
+        bool fitsOffset(Node* list, K delta) const;
+        bool shiftFits(K delta);
+        inline K toStored(K key);
+        inline K toKey(K storedKey) const { return KeyMath::saturatedAdd(storedKey, offset); };
 
         void meldNode(Node* node);
-        void consolidate();
-        Node* link(Node* a, Node* b);
+        void restoreMin() const;
+        void consolidate() const;
+
+        template <typename Visitor>
+        bool traverse(Node* list, Visitor visit, size_t maxDepth = SIZE_MAX) const;
 
-        inline void appendNode(Node* node);
         Node* find(Node* list, V value) const;
-        void cut(Node* node);
+        void decreaseNode(Node* node, K newKey);
+        void increaseNode(Node* node, K newKey);
+        void removeNode(Node* node);
+
+    public:
+        //Operations and their results for applyBatch
+        enum OperationType { INSERT, DECREASE_KEY, EXTRACT_MIN, REMOVE };
+
+        struct Operation {
+            OperationType type;
+            K key;
+            V value;
+        };
+
+        struct Result {
+            bool success;
+            V value;
+        };
+
+        //Formats and limits of exportStructure
+        enum ExportFormat { EXPORT_DOT, EXPORT_JSON, EXPORT_CSV };
+
+        struct ExportOptions {
+            //Roots have the depth zero
+            size_t maxDepth = SIZE_MAX;
+            size_t maxNodes = SIZE_MAX;
+
+            //Only every n-th tree of the rootlist is exported
+            size_t treeStride = 1;
+        };
+
+        //Reference to an element that stays valid until the element is extracted
+        //or removed. A meld keeps the handles of both heaps. A heap that shares
+        //its nodes with a snapshot gets new nodes on the first change, which
+        //invalidates all handles of this heap. A compaction moves all nodes
+        //and invalidates the handles as well.
+        class Handle {
+            private:
+                friend class FibonacciHeap<K,V>;
+                Node* node;
+
+                explicit Handle(Node* node) : node(node) {}
+
+            public:
+                Handle() : node(NULL) {}
+                bool isValid() const { return node != NULL; }
+        };
+
+    private:
+        void applySegment(const Operation* ops, size_t begin, size_t end, vector<Result>& results);
+        void peekNodes(size_t k, vector<const Node*>& nodes) const;
+        void findAll(Node* list, const vector<pair<V,size_t>>& targets, vector<Node*>& found) const;
 
     public:
         FibonacciHeap();
         FibonacciHeap(const FibonacciHeap<K,V>& orig);
+        FibonacciHeap(FibonacciHeap<K,V>&& orig);
         FibonacciHeap<K,V>& operator=(const FibonacciHeap<K,V>& rhs);
+        FibonacciHeap<K,V>& operator=(FibonacciHeap<K,V>&& rhs);
         ~FibonacciHeap();
 
         bool isEmpty() const;
-        void insert(K key, V value);
+        size_t size() const;
+
+        //Bytes of the heap object and its node slabs without shared nodes
+        size_t memoryUsage() const;
+
+        //Move all nodes into a single slab in tree order and release the old slabs
+        void compact();
+
+        Handle insert(K key, V value);
+        void insertParallel(const pair<K,V>* items, size_t count,
+                            unsigned int threads = 0, bool consolidateTrees = false);
         void meld(FibonacciHeap<K,V>* other);
 
         V getMin() const;
+        K getMinKey() const;
         V extractMin();
+        size_t extractUpTo(K maxKey, vector<pair<K,V>>& out);
+
+        template <typename OutputIt>
+        OutputIt peekK(size_t k, OutputIt out) const;
+
+        template <typename Visitor>
+        void forEach(Visitor visit) const;
+
+        size_t exportStructure(ostream& out, ExportFormat format,
+                               const ExportOptions& options = ExportOptions()) const;
 
         bool decreaseKey(V value, K newKey);
         bool remove(V value);
 
+        K getKey(Handle handle) const;
+        V getValue(Handle handle) const;
+        bool decreaseKey(Handle handle, K newKey);
+        bool remove(Handle handle);
+
+        //Decrease or increase the key, an increase moves the children to the rootlist
+        bool updateKey(Handle handle, K newKey);
+
+        void applyBatch(const Operation* ops, size_t count, vector<Result>& results);
+
+        //Add the delta to all keys in O(1) amortized. A shift that would move
+        //a key beyond the range of a signed key type is rejected with false.
+        bool shiftAllKeys(K delta);
+
+        void setLazy(bool lazy);
+        bool isLazy() const;
+
+        //Opt-in vector search for the new minimum after a consolidation
+        void setVectorMin(bool vectorMin);
+        bool isVectorMin() const;
+
+        //Share the forest with a new heap in O(1). The first change of a holder
+        //copies the whole forest in O(n) unless all other holders are released.
+        //Holders on different threads may be read and changed concurrently.
+        FibonacciHeap<K,V> snapshot();
+        bool isShared() const;
+        size_t sharedBytes() const;
+
         #ifdef DEBUG
-        bool invariant();
-        bool invariantList(Node* node);
-        bool invariantNode(Node* node);
-        bool invariantDegree(Node* node);
-        bool invariantHeapOrder(Node* node, K key);
-        unsigned int invariantNodeCount(Node* node);
-
-        bool normalized(Node* node);
+        bool invariant() const;
+        bool invariantSampled(initializer_list<Node*> touched) const;
+        bool invariantRoots() const;
+        bool invariantList(Node* node) const;
+        bool invariantNode(Node* node) const;
+        bool invariantDegree(Node* node) const;
+        bool invariantHeapOrder(Node* node, K key) const;
+        size_t invariantNodeCount(Node* node) const;
+
+        bool normalized(Node* node) const;
         void dump(string dumpName = "dump");
         void dumpNode(list<pair<Node*,int>>* nodeList, Node* node, int depth);
         #endif
 
 };
 
+//Preorder traversal of a list and all trees below it with an explicit stack.
+//The visitor gets each node with its depth and returns false to stop. The
+//links of a node are read before the visit, so the visitor may release it.
+//Child lists below the max depth are skipped.
+template <typename K, typename V>
+template <typename Visitor>
+bool FibonacciHeap<K,V>::traverse(Node* list, Visitor visit, size_t maxDepth) const {
+    //Resume points of the lists above the current list
+    vector<pair<Node*,Node*>> stack;
+    Node* first = list;
+    Node* curNode = list;
+
+    while (true) {
+        Node* next = curNode->next;
+        Node* child = curNode->child;
+
+        if (!visit(curNode, stack.size())) {
+            return false;
+        }
+
+        if (child != NULL && stack.size() < maxDepth) {
+            //Descend into the child list and continue with next afterwards
+            stack.push_back(make_pair(next, first));
+            first = curNode = child;
+
+        } else {
+            curNode = next;
+
+            //Return from all lists that are completed
+            while (curNode == first) {
+                if (stack.empty()) {
+                    return true;
+                }
+
+                curNode = stack.back().first;
+                first = stack.back().second;
+                stack.pop_back();
+            }
+        }
+    }
+}
+
+//Call the visitor with the key and value of all elements in no particular order
+template <typename K, typename V>
+template <typename Visitor>
+void FibonacciHeap<K,V>::forEach(Visitor visit) const {
+    if (!isEmpty()) {
+        traverse(rootlist, [&](Node* node, size_t) {
+            visit(toKey(node->key), static_cast<const V&>(node->value.get()));
+            return true;
+        });
+    }
+}
+
+//Write the k smallest key-value pairs in ascending order without changing the heap.
+//All r roots are candidates, so it takes O(r + k log n) time. After a consolidation
+//r is O(log n), after n inserts without an extraction it is n.
+template <typename K, typename V>
+template <typename OutputIt>
+OutputIt FibonacciHeap<K,V>::peekK(size_t k, OutputIt out) const {
+    vector<const Node*> nodes;
+    peekNodes(k, nodes);
+
+    for (const Node* node : nodes) {
+        *out++ = make_pair(toKey(node->key), node->value.get());
+    }
+
+    return out;
+}
+
 #endif /* FIBHEAP_H */
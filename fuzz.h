@@ -0,0 +1,419 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+using namespace std;
+
+#ifndef FUZZ_H
+#define FUZZ_H
+
+//Operations of the differential fuzzer. Copy replaces a heap with a copy
+//of itself to exercise the copy constructor and the assignment.
+enum FuzzOpType : uint8_t {
+    FUZZ_INSERT,
+    FUZZ_EXTRACT_MIN,
+    FUZZ_GET_MIN,
+    FUZZ_DECREASE_KEY,
+    FUZZ_REMOVE,
+    FUZZ_MELD,
+    FUZZ_COPY,
+    FUZZ_OP_COUNT
+};
+
+struct FuzzOp {
+    FuzzOpType type;
+    uint8_t heap;
+    uint8_t other;
+    int key;
+    int value;
+};
+
+inline ostream& operator<<(ostream& out, const FuzzOp& op) {
+    static const char* names[] = {"insert", "extractMin", "getMin", "decreaseKey", "remove", "meld", "copy"};
+    out << "heap" << (int)op.heap << "." << names[op.type] << "(";
+
+    switch (op.type) {
+        case FUZZ_INSERT: out << op.key << ", " << op.value; break;
+        case FUZZ_DECREASE_KEY: out << op.value << ", " << op.key; break;
+        case FUZZ_REMOVE: out << op.value; break;
+        case FUZZ_MELD: out << "heap" << (int)op.other; break;
+        default: break;
+    }
+
+    return out << ")";
+}
+
+//Relative weights of the generated operations, the defaults are percentages.
+//The engines search the targets of decreaseKey and remove, and melds and
+//copies are linear in the model, so the default keeps the heaps small.
+struct FuzzConfig {
+    unsigned int heaps = 2;
+    size_t maxSize = 4096;
+    int keyRange = 1 << 20;
+    unsigned int insert = 45;
+    unsigned int extractMin = 25;
+    unsigned int getMin = 5;
+    unsigned int decreaseKey = 12;
+    unsigned int remove = 8;
+    unsigned int meld = 3;
+    unsigned int copy = 2;
+
+    //Heaps that grow to the max size with all operations at rates for which
+    //the linear operations stay affordable. A heap grows by about one element
+    //per six of its operations.
+    static FuzzConfig largeHeaps(size_t maxSize = 1 << 20) {
+        FuzzConfig config;
+        config.maxSize = maxSize;
+        config.keyRange = 1 << 30;
+        config.insert = 1100;
+        config.extractMin = 760;
+        config.getMin = 100;
+        config.decreaseKey = 20;
+        config.remove = 18;
+        config.meld = 1;
+        config.copy = 1;
+        return config;
+    }
+};
+
+//Runs the same operations on an engine and on an ordered reference model
+//with O(log n) operations. Values are unique in every heap, so the model
+//can find the key of each value with an index.
+template <typename Heap>
+class DifferentialFuzzer final {
+    private:
+        struct Model {
+            multiset<pair<int,int>> items;
+            unordered_map<int,int> keys;
+
+            //Live values for the random choice of decrease and remove targets
+            vector<int> values;
+            unordered_map<int,size_t> positions;
+        };
+
+        vector<unique_ptr<Heap>> heaps;
+        vector<Model> models;
+        int nextValue;
+
+        void add(Model& model, int key, int value) {
+            model.items.insert(make_pair(key, value));
+            model.keys[value] = key;
+            model.positions[value] = model.values.size();
+            model.values.push_back(value);
+        }
+
+        void erase(Model& model, int value) {
+            int key = model.keys[value];
+            model.items.erase(model.items.find(make_pair(key, value)));
+            model.keys.erase(value);
+
+            //Swap the value with the last one to remove it in O(1)
+            size_t position = model.positions[value];
+            model.values[position] = model.values.back();
+            model.positions[model.values[position]] = position;
+            model.values.pop_back();
+            model.positions.erase(value);
+        }
+
+        bool overlaps(const Model& a, const Model& b) const {
+            for (int value : b.values) {
+                if (a.keys.count(value) > 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        //The returned value must have the minimum key of the model
+        bool checkMin(const Model& model, int value, string& error) const {
+            auto it = model.keys.find(value);
+
+            if (it == model.keys.end() || it->second != model.items.begin()->first) {
+                error = "minimum value " + to_string(value) + " does not have the key "
+                      + to_string(model.items.begin()->first);
+                return false;
+            }
+
+            return true;
+        }
+
+    public:
+        DifferentialFuzzer(unsigned int heapCount = 2) {
+            reset(heapCount);
+        }
+
+        void reset(unsigned int heapCount) {
+            heaps.clear();
+            models.assign(heapCount, Model());
+            nextValue = 0;
+
+            for (unsigned int i = 0; i < heapCount; i++) {
+                heaps.emplace_back(new Heap());
+            }
+        }
+
+        size_t size(unsigned int heap) const {
+            return models[heap].items.size();
+        }
+
+        //Apply a single operation, the operation must refer to existing heaps
+        bool step(const FuzzOp& op, string& error) {
+            Heap* heap = heaps[op.heap].get();
+            Model& model = models[op.heap];
+
+            if (heap->isEmpty() != model.items.empty()) {
+                error = "isEmpty does not match the model";
+                return false;
+            }
+
+            switch (op.type) {
+                case FUZZ_INSERT:
+                    //Values of replayed traces can be reused
+                    if (model.keys.count(op.value) == 0) {
+                        heap->insert(op.key, op.value);
+                        add(model, op.key, op.value);
+                    }
+
+                    nextValue = max(nextValue, op.value + 1);
+                    break;
+
+                case FUZZ_EXTRACT_MIN:
+                case FUZZ_GET_MIN:
+                    if (!model.items.empty()) {
+                        int value = (op.type == FUZZ_GET_MIN) ? heap->getMin() : heap->extractMin();
+
+                        if (!checkMin(model, value, error)) {
+                            return false;
+                        }
+
+                        if (op.type == FUZZ_EXTRACT_MIN) {
+                            erase(model, value);
+                        }
+                    }
+                    break;
+
+                case FUZZ_DECREASE_KEY: {
+                    auto it = model.keys.find(op.value);
+                    bool expected = it != model.keys.end() && op.key < it->second;
+
+                    if (heap->decreaseKey(op.value, op.key) != expected) {
+                        error = "decreaseKey result does not match the model";
+                        return false;
+                    }
+
+                    if (expected) {
+                        erase(model, op.value);
+                        add(model, op.key, op.value);
+                    }
+                    break;
+                }
+
+                case FUZZ_REMOVE: {
+                    bool expected = model.keys.count(op.value) > 0;
+
+                    if (heap->remove(op.value) != expected) {
+                        error = "remove result does not match the model";
+                        return false;
+                    }
+
+                    if (expected) {
+                        erase(model, op.value);
+                    }
+                    break;
+                }
+
+                case FUZZ_MELD:
+                    //Heaps with a common value are not melded to keep the values unique
+                    if (op.other != op.heap && !overlaps(model, models[op.other])) {
+                        heap->meld(heaps[op.other].get());
+
+                        for (const pair<int,int>& item : models[op.other].items) {
+                            add(model, item.first, item.second);
+                        }
+
+                        models[op.other] = Model();
+                    }
+                    break;
+
+                case FUZZ_COPY: {
+                    Heap copy(*heap);
+                    *heap = copy;
+                    break;
+                }
+
+                default:
+                    error = "unknown operation";
+                    return false;
+            }
+
+            return true;
+        }
+
+        //Index of the first failing operation or the number of operations
+        size_t run(const vector<FuzzOp>& ops, string& error) {
+            for (size_t i = 0; i < ops.size(); i++) {
+                if (!step(ops[i], error)) {
+                    return i;
+                }
+            }
+
+            return ops.size();
+        }
+
+        //Random operation that mostly targets values in the heap
+        FuzzOp generate(mt19937& rng, const FuzzConfig& config) {
+            FuzzOp op;
+            op.heap = (uint8_t)(rng() % heaps.size());
+            op.other = (uint8_t)(rng() % heaps.size());
+            op.key = 0;
+            op.value = 0;
+
+            Model& model = models[op.heap];
+            unsigned int total = config.insert + config.extractMin + config.getMin +
+                                 config.decreaseKey + config.remove + config.meld + config.copy;
+            unsigned int r = rng() % total;
+
+            //Full heaps are reduced by extractions
+            if (model.items.size() >= config.maxSize && r < config.insert) {
+                r = config.insert;
+            }
+
+            const unsigned int weights[] = {config.insert, config.extractMin, config.getMin,
+                                            config.decreaseKey, config.remove, config.meld, config.copy};
+            unsigned int type = 0;
+
+            while (r >= weights[type]) {
+                r -= weights[type];
+                type++;
+            }
+
+            op.type = (FuzzOpType)type;
+            bool existing = !model.values.empty() && rng() % 16 != 0;
+            int target = existing ? model.values[rng() % model.values.size()] : (int)(rng() % (nextValue + 1));
+
+            switch (op.type) {
+                case FUZZ_INSERT:
+                    op.key = (int)(rng() % config.keyRange) - config.keyRange / 2;
+                    op.value = nextValue;
+                    break;
+
+                case FUZZ_DECREASE_KEY:
+                    op.value = target;
+                    op.key = (model.keys.count(target) ? model.keys[target] : 0) - (int)(rng() % 1024);
+                    break;
+
+                case FUZZ_REMOVE:
+                    op.value = target;
+                    break;
+
+                default:
+                    break;
+            }
+
+            return op;
+        }
+};
+
+//Generate and check random operations, the executed operations are returned
+template <typename Heap>
+bool fuzzRandom(size_t count, unsigned int seed, const FuzzConfig& config,
+                vector<FuzzOp>& ops, string& error) {
+    DifferentialFuzzer<Heap> fuzzer(config.heaps);
+    mt19937 rng(seed);
+    ops.clear();
+
+    for (size_t i = 0; i < count; i++) {
+        ops.push_back(fuzzer.generate(rng, config));
+
+        if (!fuzzer.step(ops.back(), error)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//Delta debugging of a failing operation sequence. Chunks of operations are
+//removed as long as the remaining sequence still fails.
+template <typename Heap>
+vector<FuzzOp> fuzzMinimize(vector<FuzzOp> ops, unsigned int heapCount) {
+    string error;
+
+    auto failing = [heapCount, &error](vector<FuzzOp>& candidate) {
+        DifferentialFuzzer<Heap> fuzzer(heapCount);
+        size_t failed = fuzzer.run(candidate, error);
+
+        //Operations after the first failure are not needed
+        if (failed < candidate.size()) {
+            candidate.resize(failed + 1);
+            return true;
+        }
+
+        return false;
+    };
+
+    if (!failing(ops)) {
+        return ops;
+    }
+
+    size_t chunks = 2;
+
+    while (ops.size() >= 2) {
+        size_t chunk = (ops.size() + chunks - 1) / chunks;
+        bool reduced = false;
+
+        for (size_t begin = 0; begin < ops.size(); begin += chunk) {
+            vector<FuzzOp> candidate(ops.begin(), ops.begin() + begin);
+            candidate.insert(candidate.end(), ops.begin() + min(ops.size(), begin + chunk), ops.end());
+
+            if (failing(candidate)) {
+                ops = candidate;
+                chunks = max(chunks - 1, (size_t)2);
+                reduced = true;
+                break;
+            }
+        }
+
+        if (!reduced) {
+            if (chunk == 1) {
+                break;
+            }
+
+            chunks = min(chunks * 2, ops.size());
+        }
+    }
+
+    return ops;
+}
+
+//Operations from raw bytes for coverage guided fuzzing. Every operation
+//uses four bytes and the keys and values stay small to provoke collisions.
+inline vector<FuzzOp> fuzzDecode(const uint8_t* data, size_t size, unsigned int heapCount) {
+    vector<FuzzOp> ops;
+
+    for (size_t i = 0; i + 4 <= size; i += 4) {
+        FuzzOp op;
+        op.type = (FuzzOpType)(data[i] % FUZZ_OP_COUNT);
+        op.heap = (uint8_t)((data[i] / FUZZ_OP_COUNT) % heapCount);
+        op.other = (uint8_t)(data[i + 1] % heapCount);
+        op.key = (int)(int8_t)data[i + 2];
+        op.value = (int)data[i + 3];
+        ops.push_back(op);
+    }
+
+    return ops;
+}
+
+#endif /* FUZZ_H */
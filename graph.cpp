@@ -0,0 +1,206 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <sstream>
+#include <random>
+#include "graph.h"
+
+const long long ShortestPaths::unreachable;
+const uint32_t ShortestPaths::none;
+
+CsrGraph::CsrGraph() {
+    offsets.assign(1, 0);
+}
+
+CsrGraph::CsrGraph(uint32_t vertices, const vector<GraphEdge>& edges) {
+    offsets.assign((size_t)vertices + 1, 0);
+    targets.resize(edges.size());
+    weights.resize(edges.size());
+
+    //Counting sort of the edges by their source
+    for (const GraphEdge& edge : edges) {
+        offsets[edge.source + 1]++;
+    }
+
+    for (uint32_t v = 0; v < vertices; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    vector<size_t> next(offsets.begin(), offsets.end() - 1);
+
+    for (const GraphEdge& edge : edges) {
+        size_t index = next[edge.source]++;
+        targets[index] = edge.target;
+        weights[index] = edge.weight;
+    }
+}
+
+uint32_t CsrGraph::vertexCount() const {
+    return (uint32_t)(offsets.size() - 1);
+}
+
+size_t CsrGraph::edgeCount() const {
+    return targets.size();
+}
+
+bool loadDimacs(istream& in, CsrGraph& graph, string& error) {
+    vector<GraphEdge> edges;
+    unsigned long long vertices = 0;
+    bool problem = false;
+    string line;
+    size_t lineNumber = 0;
+
+    while (getline(in, line)) {
+        lineNumber++;
+
+        if (line.empty() || line[0] == 'c') {
+            continue;
+        }
+
+        stringstream fields(line);
+        string type;
+        fields >> type;
+
+        if (type == "p") {
+            string format;
+            unsigned long long arcs;
+
+            if (problem || !(fields >> format >> vertices >> arcs) || format != "sp" || vertices >= UINT32_MAX) {
+                error = "invalid problem line " + to_string(lineNumber);
+                return false;
+            }
+
+            problem = true;
+            edges.reserve(arcs);
+
+        } else if (type == "a") {
+            unsigned long long source, target;
+            int weight;
+
+            if (!problem || !(fields >> source >> target >> weight) ||
+                source < 1 || source > vertices || target < 1 || target > vertices) {
+                error = "invalid arc in line " + to_string(lineNumber);
+                return false;
+            }
+
+            //Dijkstra and A* need non-negative weights
+            if (weight < 0) {
+                error = "negative weight in line " + to_string(lineNumber);
+                return false;
+            }
+
+            edges.push_back({(uint32_t)(source - 1), (uint32_t)(target - 1), weight});
+
+        } else {
+            error = "unknown line type in line " + to_string(lineNumber);
+            return false;
+        }
+    }
+
+    if (!problem) {
+        error = "missing problem line";
+        return false;
+    }
+
+    graph = CsrGraph((uint32_t)vertices, edges);
+    return true;
+}
+
+bool loadEdgeList(istream& in, CsrGraph& graph, string& error, bool undirected) {
+    vector<GraphEdge> edges;
+    uint32_t vertices = 0;
+    string line;
+    size_t lineNumber = 0;
+
+    while (getline(in, line)) {
+        lineNumber++;
+
+        if (line.empty() || line[0] == '#' || line[0] == '%') {
+            continue;
+        }
+
+        stringstream fields(line);
+        unsigned long long source, target;
+        int weight = 1;
+
+        if (!(fields >> source >> target) || source >= UINT32_MAX || target >= UINT32_MAX) {
+            error = "invalid edge in line " + to_string(lineNumber);
+            return false;
+        }
+
+        //The weight is optional
+        if (!(fields >> weight)) {
+            weight = 1;
+        } else if (weight < 0) {
+            error = "negative weight in line " + to_string(lineNumber);
+            return false;
+        }
+
+        edges.push_back({(uint32_t)source, (uint32_t)target, weight});
+        vertices = max(vertices, (uint32_t)max(source, target) + 1);
+
+        if (undirected) {
+            edges.push_back({(uint32_t)target, (uint32_t)source, weight});
+        }
+    }
+
+    graph = CsrGraph(vertices, edges);
+    return true;
+}
+
+CsrGraph randomGraph(uint32_t vertices, unsigned int degree, int maxWeight, unsigned int seed, bool undirected) {
+    if (vertices == 0) {
+        return CsrGraph();
+    }
+
+    mt19937 rng(seed);
+    uniform_int_distribution<uint32_t> vertex(0, vertices - 1);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    vector<GraphEdge> edges;
+    edges.reserve((size_t)vertices * degree * (undirected ? 2 : 1));
+
+    for (uint32_t v = 0; v < vertices; v++) {
+        for (unsigned int i = 0; i < degree; i++) {
+            //Chain all vertices to keep the graph connected
+            GraphEdge edge = {v, (i == 0) ? (v + 1) % vertices : vertex(rng), weight(rng)};
+            edges.push_back(edge);
+
+            //Both directions of an edge have the same weight
+            if (undirected) {
+                edges.push_back({edge.target, edge.source, edge.weight});
+            }
+        }
+    }
+
+    return CsrGraph(vertices, edges);
+}
+
+CsrGraph gridGraph(uint32_t width, int maxWeight, unsigned int seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    vector<GraphEdge> edges;
+    edges.reserve((size_t)width * width * 4);
+
+    for (uint32_t y = 0; y < width; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint32_t v = y * width + x;
+
+            //Both directions of an edge have the same weight
+            if (x + 1 < width) {
+                int w = weight(rng);
+                edges.push_back({v, v + 1, w});
+                edges.push_back({v + 1, v, w});
+            }
+
+            if (y + 1 < width) {
+                int w = weight(rng);
+                edges.push_back({v, v + width, w});
+                edges.push_back({v + width, v, w});
+            }
+        }
+    }
+
+    return CsrGraph(width * width, edges);
+}
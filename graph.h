@@ -0,0 +1,269 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include "fibheap.h"
+
+using namespace std;
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+struct GraphEdge {
+    uint32_t source;
+    uint32_t target;
+    int weight;
+};
+
+//Weighted directed graph in compressed sparse row format. The edges of a
+//vertex v are the indices from edgeBegin(v) to edgeEnd(v). Undirected
+//graphs contain every edge in both directions.
+class CsrGraph final {
+    private:
+        vector<size_t> offsets;
+        vector<uint32_t> targets;
+        vector<int> weights;
+
+    public:
+        CsrGraph();
+        CsrGraph(uint32_t vertices, const vector<GraphEdge>& edges);
+
+        uint32_t vertexCount() const;
+        size_t edgeCount() const;
+
+        size_t edgeBegin(uint32_t vertex) const { return offsets[vertex]; }
+        size_t edgeEnd(uint32_t vertex) const { return offsets[vertex + 1]; }
+        uint32_t target(size_t edge) const { return targets[edge]; }
+        int weight(size_t edge) const { return weights[edge]; }
+};
+
+//DIMACS shortest path format with the problem line "p sp n m" and the arcs
+//"a u v w" with vertices from 1 to n. Comment lines start with c. Negative
+//weights are rejected.
+bool loadDimacs(istream& in, CsrGraph& graph, string& error);
+
+//Lines with "u v" or "u v w" and vertices from zero, the weight defaults to
+//one and must not be negative. Lines starting with # or % are comments.
+bool loadEdgeList(istream& in, CsrGraph& graph, string& error, bool undirected = false);
+
+//Graph with a chain through all vertices to reach every vertex. Undirected
+//graphs have both directions of every edge, which prim requires.
+CsrGraph randomGraph(uint32_t vertices, unsigned int degree, int maxWeight, unsigned int seed,
+                     bool undirected = false);
+
+//Undirected grid of width times width vertices with the vertex y * width + x
+CsrGraph gridGraph(uint32_t width, int maxWeight, unsigned int seed);
+
+//Distances from the source and the previous vertex on a shortest path
+struct ShortestPaths {
+    static const long long unreachable = numeric_limits<long long>::max();
+    static const uint32_t none = UINT32_MAX;
+
+    vector<long long> distance;
+    vector<uint32_t> parent;
+};
+
+//Detection of engines whose insert returns a handle
+template <typename...>
+struct GraphVoid {
+    typedef void type;
+};
+
+//Queue of vertices for engines without handles. A decrease inserts the vertex
+//again and the algorithms skip the stale entries of settled vertices.
+template <template <typename, typename> class Heap, typename = void>
+class GraphQueue final {
+    private:
+        Heap<long long,uint32_t> heap;
+
+    public:
+        GraphQueue(uint32_t) {}
+
+        bool isEmpty() const { return heap.isEmpty(); }
+        uint32_t extractMin() { return heap.extractMin(); }
+        void insert(long long key, uint32_t vertex) { heap.insert(key, vertex); }
+        void decreaseKey(long long key, uint32_t vertex) { heap.insert(key, vertex); }
+};
+
+//Engines with handles decrease the key in place without a search
+template <template <typename, typename> class Heap>
+class GraphQueue<Heap, typename GraphVoid<typename Heap<long long,uint32_t>::Handle>::type> final {
+    private:
+        Heap<long long,uint32_t> heap;
+        vector<typename Heap<long long,uint32_t>::Handle> handles;
+
+    public:
+        GraphQueue(uint32_t vertices) : handles(vertices) {}
+
+        bool isEmpty() const { return heap.isEmpty(); }
+        uint32_t extractMin() { return heap.extractMin(); }
+        void insert(long long key, uint32_t vertex) { handles[vertex] = heap.insert(key, vertex); }
+        void decreaseKey(long long key, uint32_t vertex) { heap.decreaseKey(handles[vertex], key); }
+};
+
+//Single source shortest paths for non-negative weights
+template <template <typename, typename> class Heap = FibonacciHeap>
+ShortestPaths dijkstra(const CsrGraph& graph, uint32_t source) {
+    uint32_t n = graph.vertexCount();
+    ShortestPaths paths;
+    paths.distance.assign(n, ShortestPaths::unreachable);
+    paths.parent.assign(n, ShortestPaths::none);
+
+    vector<bool> settled(n, false);
+    GraphQueue<Heap> queue(n);
+
+    paths.distance[source] = 0;
+    queue.insert(0, source);
+
+    while (!queue.isEmpty()) {
+        uint32_t u = queue.extractMin();
+
+        if (settled[u]) {
+            continue;
+        }
+
+        settled[u] = true;
+
+        for (size_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            uint32_t v = graph.target(e);
+            long long d = paths.distance[u] + graph.weight(e);
+
+            if (!settled[v] && d < paths.distance[v]) {
+                if (paths.distance[v] == ShortestPaths::unreachable) {
+                    queue.insert(d, v);
+                } else {
+                    queue.decreaseKey(d, v);
+                }
+
+                paths.distance[v] = d;
+                paths.parent[v] = u;
+            }
+        }
+    }
+
+    return paths;
+}
+
+//Shortest path from the source to the target guided by a consistent heuristic
+//that never overestimates the remaining distance. The vertices of the path are
+//written to path when it is not NULL. Returns unreachable without a path.
+template <template <typename, typename> class Heap = FibonacciHeap, typename Heuristic>
+long long astar(const CsrGraph& graph, uint32_t source, uint32_t target,
+                Heuristic heuristic, vector<uint32_t>* path = NULL) {
+    uint32_t n = graph.vertexCount();
+    vector<long long> distance(n, ShortestPaths::unreachable);
+    vector<uint32_t> parent(n, ShortestPaths::none);
+    vector<bool> settled(n, false);
+    GraphQueue<Heap> queue(n);
+
+    distance[source] = 0;
+    queue.insert(heuristic(source), source);
+
+    while (!queue.isEmpty()) {
+        uint32_t u = queue.extractMin();
+
+        if (settled[u]) {
+            continue;
+        }
+
+        settled[u] = true;
+
+        if (u == target) {
+            break;
+        }
+
+        for (size_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            uint32_t v = graph.target(e);
+            long long d = distance[u] + graph.weight(e);
+
+            if (!settled[v] && d < distance[v]) {
+                if (distance[v] == ShortestPaths::unreachable) {
+                    queue.insert(d + heuristic(v), v);
+                } else {
+                    queue.decreaseKey(d + heuristic(v), v);
+                }
+
+                distance[v] = d;
+                parent[v] = u;
+            }
+        }
+    }
+
+    if (path != NULL) {
+        path->clear();
+
+        if (settled[target]) {
+            for (uint32_t v = target; v != ShortestPaths::none; v = parent[v]) {
+                path->push_back(v);
+            }
+
+            reverse(path->begin(), path->end());
+        }
+    }
+
+    return settled[target] ? distance[target] : ShortestPaths::unreachable;
+}
+
+//Minimum spanning forest of an undirected graph. The parent of every vertex
+//in its tree is written to parent when it is not NULL. Returns the total weight.
+template <template <typename, typename> class Heap = FibonacciHeap>
+long long prim(const CsrGraph& graph, vector<uint32_t>* parent = NULL) {
+    uint32_t n = graph.vertexCount();
+    vector<long long> cost(n, ShortestPaths::unreachable);
+    vector<uint32_t> tree(n, ShortestPaths::none);
+    vector<bool> spanned(n, false);
+    GraphQueue<Heap> queue(n);
+    long long total = 0;
+
+    //Every vertex that is not spanned yet starts a new tree
+    for (uint32_t root = 0; root < n; root++) {
+        if (spanned[root]) {
+            continue;
+        }
+
+        cost[root] = 0;
+        queue.insert(0, root);
+
+        while (!queue.isEmpty()) {
+            uint32_t u = queue.extractMin();
+
+            if (spanned[u]) {
+                continue;
+            }
+
+            spanned[u] = true;
+            total += cost[u];
+
+            for (size_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+                uint32_t v = graph.target(e);
+
+                if (!spanned[v] && graph.weight(e) < cost[v]) {
+                    if (cost[v] == ShortestPaths::unreachable) {
+                        queue.insert(graph.weight(e), v);
+                    } else {
+                        queue.decreaseKey(graph.weight(e), v);
+                    }
+
+                    cost[v] = graph.weight(e);
+                    tree[v] = u;
+                }
+            }
+        }
+    }
+
+    if (parent != NULL) {
+        *parent = tree;
+    }
+
+    return total;
+}
+
+#endif /* GRAPH_H */
@@ -0,0 +1,435 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "kwaymerge.h"
+
+static const char newline = '\n';
+
+const size_t MergeWriter::copyLimit;
+
+MergeWriter::MergeWriter(int fd) : staging(1 << 16) {
+    this->fd = fd;
+    staged = 0;
+    recordEnd = NULL;
+    direct = false;
+    writes = 0;
+    failed = false;
+    pending.reserve(IOV_MAX);
+}
+
+MergeWriter::~MergeWriter() {
+    flush();
+}
+
+bool MergeWriter::append(const MergeRecord& record) {
+    bool follows = (record.data == recordEnd);
+    recordEnd = record.data + record.length;
+
+    if (follows && direct) {
+        //Consecutive lines of the same input are written as one block
+        pending.back().iov_len += record.length;
+
+    } else if (!follows && record.length < copyLimit) {
+        if (staged + record.length + 1 > staging.size() && !flush()) {
+            return false;
+        }
+
+        char* target = staging.data() + staged;
+        memcpy(target, record.data, record.length);
+
+        if (!pending.empty() && (char*)pending.back().iov_base + pending.back().iov_len == target) {
+            pending.back().iov_len += record.length;
+        } else {
+            pending.push_back({target, record.length});
+        }
+
+        staged += record.length;
+        direct = false;
+
+    } else {
+        pending.push_back({(void*)record.data, record.length});
+        direct = true;
+    }
+
+    if (record.length == 0 || record.data[record.length - 1] != '\n') {
+        pending.push_back({(void*)&newline, 1});
+        direct = false;
+    }
+
+    if (pending.size() >= IOV_MAX - 1) {
+        return flush();
+    }
+
+    return !failed;
+}
+
+bool MergeWriter::flush() {
+    size_t first = 0;
+
+    while (!failed && first < pending.size()) {
+        int count = (int)min(pending.size() - first, (size_t)IOV_MAX);
+        ssize_t written = writev(fd, &pending[first], count);
+
+        if (written < 0) {
+            if (errno != EINTR) {
+                failed = true;
+            }
+
+            continue;
+        }
+
+        writes++;
+
+        //Skip the written blocks and shorten a partially written one
+        size_t left = (size_t)written;
+
+        while (first < pending.size() && left >= pending[first].iov_len) {
+            left -= pending[first].iov_len;
+            first++;
+        }
+
+        if (left > 0) {
+            pending[first].iov_base = (char*)pending[first].iov_base + left;
+            pending[first].iov_len -= left;
+        }
+    }
+
+    pending.clear();
+    staged = 0;
+    direct = false;
+    return !failed;
+}
+
+size_t MergeWriter::writeCount() const {
+    return writes;
+}
+
+bool MergeWriter::hasFailed() const {
+    return failed;
+}
+
+MergeInput::MergeInput() {
+    fd = -1;
+    data = NULL;
+    size = 0;
+    mapped = false;
+    position = 0;
+    endOfInput = true;
+    failed = false;
+    line = 0;
+}
+
+MergeInput::MergeInput(MergeInput&& orig) : name(move(orig.name)), buffer(move(orig.buffer)) {
+    //The moved buffer keeps its storage, so data stays valid
+    fd = orig.fd;
+    data = orig.data;
+    size = orig.size;
+    mapped = orig.mapped;
+    position = orig.position;
+    endOfInput = orig.endOfInput;
+    failed = orig.failed;
+    line = orig.line;
+
+    orig.fd = -1;
+    orig.data = NULL;
+    orig.size = 0;
+    orig.mapped = false;
+}
+
+MergeInput::~MergeInput() {
+    close();
+}
+
+void MergeInput::close() {
+    if (mapped) {
+        munmap((void*)data, size);
+        mapped = false;
+    }
+
+    if (fd >= 0 && fd != STDIN_FILENO) {
+        ::close(fd);
+    }
+
+    fd = -1;
+}
+
+bool MergeInput::open(const string& path, bool map, size_t bufferSize, string& error) {
+    close();
+    name = path;
+    data = NULL;
+    size = 0;
+    position = 0;
+    failed = false;
+    line = 0;
+
+    if (path == "-") {
+        fd = STDIN_FILENO;
+    } else {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    struct stat info;
+
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        error = path + ": " + strerror(errno);
+        close();
+        return false;
+    }
+
+    if (map && S_ISREG(info.st_mode)) {
+        if (info.st_size == 0) {
+            endOfInput = true;
+            close();
+            return true;
+        }
+
+        void* region = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        //The descriptor is not needed for a mapping, so hundreds of inputs
+        //do not run into the limit of open files
+        if (region != MAP_FAILED) {
+            madvise(region, (size_t)info.st_size, MADV_SEQUENTIAL);
+            data = (const char*)region;
+            size = (size_t)info.st_size;
+            mapped = true;
+            endOfInput = true;
+            ::close(fd);
+            fd = -1;
+            return true;
+        }
+    }
+
+    if (S_ISREG(info.st_mode)) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    buffer.resize(max(bufferSize, (size_t)4096));
+    data = buffer.data();
+    endOfInput = false;
+    return true;
+}
+
+void MergeInput::openMemory(const string& name, const char* data, size_t size) {
+    close();
+    this->name = name;
+    this->data = data;
+    this->size = size;
+    position = 0;
+    endOfInput = true;
+    failed = false;
+    line = 0;
+}
+
+bool MergeInput::refill(MergeWriter& writer) {
+    //Written records may still point into the buffer
+    if (!writer.flush()) {
+        return false;
+    }
+
+    size_t remaining = size - position;
+
+    //A line longer than the buffer
+    if (remaining == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+
+    memmove(buffer.data(), buffer.data() + position, remaining);
+    data = buffer.data();
+    size = remaining;
+    position = 0;
+
+    while (size < buffer.size()) {
+        ssize_t count = read(fd, buffer.data() + size, buffer.size() - size);
+
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            failed = true;
+            return false;
+        }
+
+        if (count == 0) {
+            endOfInput = true;
+            break;
+        }
+
+        size += (size_t)count;
+    }
+
+    return true;
+}
+
+bool MergeInput::next(MergeRecord& record, MergeWriter& writer) {
+    while (true) {
+        if (position < size) {
+            const char* start = data + position;
+            const char* end = (const char*)memchr(start, '\n', size - position);
+
+            if (end != NULL || endOfInput) {
+                //The last line may have no newline
+                record.data = start;
+                record.length = (end != NULL) ? (size_t)(end - start) + 1 : size - position;
+                position += record.length;
+                line++;
+                return true;
+            }
+
+        } else if (endOfInput) {
+            return false;
+        }
+
+        if (!refill(writer)) {
+            return false;
+        }
+    }
+}
+
+const string& MergeInput::getName() const {
+    return name;
+}
+
+size_t MergeInput::getLine() const {
+    return line;
+}
+
+bool MergeInput::hasFailed() const {
+    return failed;
+}
+
+bool parseMergeKey(const MergeRecord& record, unsigned int field, long long& key) {
+    const char* p = record.data;
+    const char* end = record.data + record.length;
+
+    //Skip to the start of the field
+    for (unsigned int i = 1; ; i++) {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            p++;
+        }
+
+        if (i == field || p == end) {
+            break;
+        }
+
+        while (p < end && *p != ' ' && *p != '\t') {
+            p++;
+        }
+    }
+
+    bool negative = (p < end && *p == '-');
+    p += negative ? 1 : 0;
+
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+
+    unsigned long long value = 0;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (value > (ULLONG_MAX - 9) / 10) {
+            return false;
+        }
+
+        value = value * 10 + (unsigned long long)(*p++ - '0');
+    }
+
+    if (value > (unsigned long long)LLONG_MAX) {
+        return false;
+    }
+
+    key = negative ? -(long long)value : (long long)value;
+    return true;
+}
+
+//Read the next record of an input and check its order
+static bool readHead(MergeInput& input, MergeWriter& writer, unsigned int keyField,
+                     MergeRecord& head, long long& key, bool& found, string& error) {
+    long long previous = key;
+    found = input.next(head, writer);
+
+    if (!found) {
+        if (input.hasFailed()) {
+            error = input.getName() + ": " + strerror(errno);
+            return false;
+        }
+
+        return true;
+    }
+
+    if (!parseMergeKey(head, keyField, key)) {
+        error = input.getName() + ":" + to_string(input.getLine()) + ": no integer key in field " + to_string(keyField);
+        return false;
+    }
+
+    if (input.getLine() > 1 && key < previous) {
+        error = input.getName() + ":" + to_string(input.getLine()) + ": input is not sorted";
+        return false;
+    }
+
+    return true;
+}
+
+bool kwayMerge(vector<MergeInput>& inputs, MergeWriter& writer,
+               unsigned int keyField, size_t& records, string& error) {
+    typedef FibonacciHeap<long long,unsigned int> Heap;
+
+    Heap heap;
+    vector<MergeRecord> heads(inputs.size());
+    vector<long long> keys(inputs.size(), 0);
+    records = 0;
+
+    for (unsigned int i = 0; i < inputs.size(); i++) {
+        bool found;
+
+        if (!readHead(inputs[i], writer, keyField, heads[i], keys[i], found, error)) {
+            return false;
+        }
+
+        if (found) {
+            heap.insert(keys[i], i);
+        }
+    }
+
+    while (!heap.isEmpty() && !writer.hasFailed()) {
+        unsigned int i = heap.extractMin();
+        bool last = heap.isEmpty();
+        long long bound = last ? 0 : heap.getMinKey();
+        bool found = false;
+
+        //An input is written without heap operations as long as its records
+        //are not larger than the heads of the other inputs. Log segments
+        //mostly cover separate time ranges, so the runs are long.
+        do {
+            if (!writer.append(heads[i])) {
+                break;
+            }
+
+            records++;
+
+            if (!readHead(inputs[i], writer, keyField, heads[i], keys[i], found, error)) {
+                return false;
+            }
+        } while (found && (last || keys[i] <= bound));
+
+        if (found) {
+            heap.insert(keys[i], i);
+        }
+    }
+
+    if (!writer.flush()) {
+        error = string("cannot write the output: ") + strerror(errno);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <sys/uio.h>
+#include "fibheap.h"
+
+using namespace std;
+
+#ifndef KWAYMERGE_H
+#define KWAYMERGE_H
+
+//Line of an input including its newline, it points into the input buffer
+struct MergeRecord {
+    const char* data;
+    size_t length;
+};
+
+//Output that writes records from the input buffers with writev instead of
+//copying them. Records that follow each other in memory share one iovec.
+//Short single records are copied into a staging buffer, since the kernel
+//handles a few large blocks faster than many tiny ones.
+class MergeWriter final {
+    private:
+        static const size_t copyLimit = 256;
+
+        int fd;
+        vector<iovec> pending;
+        vector<char> staging;
+        size_t staged;
+
+        //End of the last record and whether its block points into the input
+        const char* recordEnd;
+        bool direct;
+
+        size_t writes;
+        bool failed;
+
+    public:
+        MergeWriter(int fd);
+        ~MergeWriter();
+
+        MergeWriter(const MergeWriter&) = delete;
+        MergeWriter& operator=(const MergeWriter&) = delete;
+
+        //A newline is added to records without one
+        bool append(const MergeRecord& record);
+        bool flush();
+
+        size_t writeCount() const;
+        bool hasFailed() const;
+};
+
+//Sorted input of newline separated records. Regular files are mapped into
+//memory and read sequentially, all other inputs use a large buffer.
+class MergeInput final {
+    private:
+        string name;
+        int fd;
+
+        //Mapped file or memory block, otherwise the buffer holds the data
+        const char* data;
+        size_t size;
+        bool mapped;
+
+        vector<char> buffer;
+        size_t position;
+        bool endOfInput;
+        bool failed;
+
+        size_t line;
+
+        bool refill(MergeWriter& writer);
+        void close();
+
+    public:
+        MergeInput();
+        MergeInput(MergeInput&& orig);
+        ~MergeInput();
+
+        MergeInput(const MergeInput&) = delete;
+        MergeInput& operator=(const MergeInput&) = delete;
+
+        //The path - reads from stdin
+        bool open(const string& path, bool map, size_t bufferSize, string& error);
+        void openMemory(const string& name, const char* data, size_t size);
+
+        //The writer is flushed before the buffer is reused, so written
+        //records never point to overwritten data
+        bool next(MergeRecord& record, MergeWriter& writer);
+
+        const string& getName() const;
+        size_t getLine() const;
+        bool hasFailed() const;
+};
+
+//Integer key of a record in the whitespace separated field from 1
+bool parseMergeKey(const MergeRecord& record, unsigned int field, long long& key);
+
+//Merge inputs sorted by the integer key in the key field. A heap holds the
+//head record of every input. Equal keys keep their order within an input,
+//the order of equal keys from different inputs is unspecified.
+bool kwayMerge(vector<MergeInput>& inputs, MergeWriter& writer,
+               unsigned int keyField, size_t& records, string& error);
+
+#endif /* KWAYMERGE_H */
@@ -7,17 +7,43 @@
 #include <iomanip>
 #include <algorithm>
 #include <vector>
+#include <set>
 #include <numeric>
+#include <climits>
+#include <stdexcept>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #ifndef DEBUG
 #define DEBUG
 #endif
 
 #include "fibheap.h"
+#include "staticfibheap.h"
+#include "radixheap.h"
+#include "pairingheap.h"
+#include "rpheap.h"
+#include "coalescingheap.h"
+#include "payload.h"
+#include "graph.h"
+#include "kwaymerge.h"
+#include "scheduler.h"
+#include "softheap.h"
+#include "simdmin.h"
+#include "trace.h"
+#include "fuzz.h"
+#include "timerqueue.h"
 using namespace std;
 
 typedef FibonacciHeap<int,char> FibHeap;
 typedef FibonacciHeap<int,int> FibInt;
+typedef StaticFibonacciHeap<int,char,64> StaticFibHeap;
+typedef StaticFibonacciHeap<int,int,8192> StaticFibInt;
+typedef RadixHeap<int,int> RadixInt;
 
 #define TestPassed {return true;}
 #define AssertEquals(exp, act) ({\
@@ -26,7 +52,7 @@ typedef FibonacciHeap<int,int> FibInt;
         return false;\
     }\
 })
-#define AssertTrue(x) ({if(!x) {return false;}})
+#define AssertTrue(x) ({if(!(x)) {return false;}})
 #define AssertFalse(x) ({if(x) {return false;}})
 
 typedef enum TestResult {
@@ -66,80 +92,20 @@ void Test::run() {
     this->result = this->test() ? SUCCESS : FAILED;
 }
 
-//Test helper functions
-class TestQueue {
-    private:
-        list<pair<int,int>> l;
-
-    public:
-        bool isEmpty();
-        void insert(int key, int value);
-        int extractMin();
-
-        bool decreaseKey(int value, int newKey);
-        bool remove(int value);
-};
-
-bool TestQueue::isEmpty() {
-    return l.empty();
-}
-
-void TestQueue::insert(int key, int value) {
-    l.push_front(make_pair(key,value));
-}
-
-int TestQueue::extractMin() {
-    if (isEmpty()) {
-        assert(false);
-
-    } else {
-        pair<int,int> min = l.front();
+//Test helper functions, the ordered set of key and value pairs is the
+//reference queue with O(log n) operations
+typedef set<pair<int,int>> TestQueue;
 
-        for (auto const& p: l) {
-            if (p.first < min.first) {
-                min = p;
-            }
-        }
-
-        l.remove(min);
-        return min.second;
-    }
-}
-
-bool TestQueue::decreaseKey(int value, int newKey) {
-    bool decreasedKey = false;
-
-    for (list<pair<int,int>>::iterator it = l.begin(); it != l.end(); ++it) {
-        if (it->first == value && newKey < it->first) {
-            *it = make_pair(newKey, it->second);
-            decreasedKey = true;
-        }
-    }
-
-    return decreasedKey;
-}
-
-bool TestQueue::remove(int value) {
-    if (isEmpty()) {
-        return false;
-
-    } else {
-        pair<int,int> target;
-
-        for (auto const& p: l) {
-            if (p.second == value) {
-                target = p;
-            }
-        }
-
-        l.remove(target);
-        return true;
-    }
+static int extractMin(TestQueue& queue) {
+    int value = queue.begin()->second;
+    queue.erase(queue.begin());
+    return value;
 }
 
+template <typename Heap = FibInt>
 bool randomTest(unsigned int inserts, unsigned int extracts, int p, unsigned int seed) {
     TestQueue testQueue;
-    FibInt* h = new FibInt();
+    Heap* h = new Heap();
     srand(seed);
 
     //Number of elements in the queue
@@ -166,7 +132,7 @@ bool randomTest(unsigned int inserts, unsigned int extracts, int p, unsigned int
             int val = items.at(curItem++);
 
             h->insert(key, val);
-            testQueue.insert(key, val);
+            testQueue.insert(make_pair(key, val));
             insertsDone++;
             count++;
 
@@ -176,7 +142,7 @@ bool randomTest(unsigned int inserts, unsigned int extracts, int p, unsigned int
 
         } else {
             //Extract
-            AssertEquals(testQueue.extractMin(), h->extractMin());
+            AssertEquals(extractMin(testQueue), h->extractMin());
             extractsDone++;
             count--;
         }
@@ -184,16 +150,96 @@ bool randomTest(unsigned int inserts, unsigned int extracts, int p, unsigned int
 
     if (inserts == extracts) {
         AssertTrue(h->isEmpty());
-        AssertTrue(testQueue.isEmpty());
+        AssertTrue(testQueue.empty());
     }
 
+    delete h;
     TestPassed;
 }
 
-int main() {
-    Test testSuite[] = {
+template <typename Heap = FibInt>
+bool monotoneTest(unsigned int inserts, int maxStep, unsigned int seed) {
+    TestQueue testQueue;
+    Heap* h = new Heap();
+    srand(seed);
+
+    //Keys are never smaller than the last extracted key
+    vector<int> keys(inserts);
+    int lastKey = 0;
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < inserts; i++) {
+        keys[i] = lastKey + (rand() % maxStep);
+        h->insert(keys[i], i);
+        testQueue.insert(make_pair(keys[i], (int)i));
+        count++;
+
+        //Extract about every second element
+        while (count > 0 && rand() % 2 == 0) {
+            //Equal keys may be extracted in a different order
+            lastKey = keys[extractMin(testQueue)];
+            AssertEquals(lastKey, keys[h->extractMin()]);
+            count--;
+        }
+    }
+
+    while (count > 0) {
+        AssertEquals(keys[extractMin(testQueue)], keys[h->extractMin()]);
+        count--;
+    }
+
+    AssertTrue(h->isEmpty());
+    delete h;
+    TestPassed;
+}
+
+//Engine that loses the melded heap to check the fuzzer minimization
+class LossyMeldHeap {
+    private:
+        FibInt heap;
+
+    public:
+        bool isEmpty() const { return heap.isEmpty(); }
+        void insert(int key, int value) { heap.insert(key, value); }
+        int getMin() const { return heap.getMin(); }
+        int extractMin() { return heap.extractMin(); }
+        bool decreaseKey(int value, int newKey) { return heap.decreaseKey(value, newKey); }
+        bool remove(int value) { return heap.remove(value); }
+        void meld(LossyMeldHeap*) {}
+};
+
+//Tests for all engines with the FibonacciHeap interface
+//Run a test on a thread with a small stack to detect deep recursion
+bool smallStackTest(TestFunc test, size_t stackSize) {
+    pthread_attr_t attr;
+    pthread_t thread;
+    bool result = false;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stackSize);
+
+    auto run = [](void* arg) -> void* {
+        pair<TestFunc,bool>* call = static_cast<pair<TestFunc,bool>*>(arg);
+        call->second = call->first();
+        return NULL;
+    };
+
+    pair<TestFunc,bool> call = make_pair(test, false);
+
+    if (pthread_create(&thread, &attr, run, &call) == 0) {
+        pthread_join(thread, NULL);
+        result = call.second;
+    }
+
+    pthread_attr_destroy(&attr);
+    return result;
+}
+
+template <typename Heap, typename IntHeap>
+void addHeapTests(vector<Test>& testSuite, string engine) {
+    pair<string,TestFunc> tests[] = {
         {"Single element insert and remove", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
 
             h->insert(1, 'A');
             AssertFalse(h->isEmpty());
@@ -204,7 +250,7 @@ int main() {
             TestPassed;
         }},
         {"Tree creation with 1 child", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             
             h->insert(2, 'B');
             h->insert(3, 'C');
@@ -216,7 +262,7 @@ int main() {
             TestPassed;
         }},
         {"Removing node with 1 child", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             
             h->insert(2, 'B');
             h->insert(3, 'C');
@@ -230,7 +276,7 @@ int main() {
             TestPassed;
         }},
         {"Consolidate with existing tree", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             
             h->insert(2, 'B');
             h->insert(3, 'C');
@@ -246,7 +292,7 @@ int main() {
             TestPassed;
         }},
         {"Consolidate with tree list", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             
             h->insert(2, 'B');
             h->insert(3, 'C');
@@ -271,7 +317,7 @@ int main() {
             TestPassed;
         }},
         {"Decrease key in the rootlist", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             
             h->insert(4, 'B');
             h->insert(6, 'C');
@@ -291,7 +337,7 @@ int main() {
             TestPassed;
         }},
         {"Decrease key with parent and single childlist", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             char c = 'A';
 
             for (int i = 1; i < 27; i++, c++) {
@@ -316,7 +362,7 @@ int main() {
             TestPassed;
         }},
         {"Decrease key with parent and childlist", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             char c = 'A';
 
             for (int i = 1; i < 27; i++, c++) {
@@ -337,7 +383,7 @@ int main() {
             TestPassed;
         }},
         {"Decrease key with marked parent", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             char c = 'A';
 
             for (int i = 1; i < 27; i++, c++) {
@@ -361,7 +407,7 @@ int main() {
             TestPassed;
         }},
         {"Decrease key with two marked parents", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             char c = 'a';
 
             for (int i = 1; i < 40; i++, c++) {
@@ -390,7 +436,7 @@ int main() {
             TestPassed;
         }},
         {"Remove with single element", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
 
             h->insert(5, 'A');
             h->remove('A');
@@ -401,7 +447,7 @@ int main() {
             TestPassed;
         }},
         {"Remove with 10 elements", []() {
-            FibHeap* h = new FibHeap();
+            Heap* h = new Heap();
             char c = 'A';
 
             for (int i = 1; i < 27; i++, c++) {
@@ -444,13 +490,13 @@ int main() {
             TestPassed;
         }},
         {"Copy constructor test", []() {
-            FibHeap h;
+            Heap h;
 
             h.insert(3, 'A');
             h.insert(4, 'B');
             h.insert(5, 'C');
 
-            FibHeap h2 = h;
+            Heap h2 = h;
             AssertEquals('A', h2.extractMin());
             AssertEquals('B', h2.extractMin());
             AssertEquals('C', h2.extractMin());
@@ -467,8 +513,8 @@ int main() {
             TestPassed;
         }},
         {"Assignment operator test", []() {
-            FibHeap h;
-            FibHeap h2;
+            Heap h;
+            Heap h2;
 
             h.insert(3, 'A');
             h.insert(4, 'B');
@@ -490,28 +536,1666 @@ int main() {
             AssertTrue(h2.isEmpty());
             TestPassed;
         }},
+        {"Meld two heaps", []() {
+            Heap h;
+            Heap h2;
+            Heap h3;
+
+            h.insert(5, 'B');
+            h.insert(9, 'D');
+            h2.insert(7, 'C');
+            h2.insert(3, 'A');
+            h2.insert(11, 'E');
+
+            h.meld(&h2);
+            AssertTrue(h2.isEmpty());
+
+            //Meld into an empty heap
+            h3.meld(&h);
+            AssertTrue(h.isEmpty());
+
+            AssertEquals('A', h3.extractMin());
+            AssertEquals('B', h3.extractMin());
+            AssertEquals('C', h3.extractMin());
+            AssertEquals('D', h3.extractMin());
+            AssertEquals('E', h3.extractMin());
+            AssertTrue(h3.isEmpty());
+            TestPassed;
+        }},
         {"Random with 10 elements", []() {
-            return randomTest(10, 10, 90, 314215183);
+            return randomTest<IntHeap>(10, 10, 90, 314215183);
         }},
         {"Random with 100 elements", []() {
-            return randomTest(100, 100, 75, 917114197);
+            return randomTest<IntHeap>(100, 100, 75, 917114197);
         }},
         {"Random with 1000 elements", []() {
-            return randomTest(1000, 1000, 65, 571381511);
+            return randomTest<IntHeap>(1000, 1000, 65, 571381511);
         }},
         {"Random with 2000 elements", []() {
-            return randomTest(2000, 2000, 55, 462969643);
+            return randomTest<IntHeap>(2000, 2000, 55, 462969643);
         }},
         {"Random with 5000 elements", []() {
-            return randomTest(5000, 5000, 75, 493825932);
+            return randomTest<IntHeap>(5000, 5000, 75, 493825932);
+        }},
+
+        {"Differential fuzzing with mixed operations", []() {
+            FuzzConfig config;
+            config.maxSize = 256;
+            config.keyRange = 512;
+
+            vector<FuzzOp> ops;
+            string error;
+
+            for (unsigned int seed = 1; seed <= 4; seed++) {
+                if (!fuzzRandom<IntHeap>(20000, seed, config, ops, error)) {
+                    cerr << endl << "Fuzzing seed " << seed << " failed: " << error << " ";
+                    return false;
+                }
+            }
+
+            TestPassed;
+        }}
+    };
+
+    for (auto& test : tests) {
+        testSuite.push_back(Test(test.first + " [" + engine + "]", test.second));
+    }
+}
+
+#ifdef __cpp_impl_coroutine
+//Tasks of the scheduler tests, coroutines can not be written as the test lambdas
+Task logRounds(vector<int>& log, int id, int rounds) {
+    for (int i = 0; i < rounds; i++) {
+        log.push_back(id);
+        co_await yield();
+    }
+}
+
+Task logAfterSleep(Scheduler& scheduler, vector<long long>& log, long long deadline) {
+    co_await sleepUntil(deadline);
+    log.push_back(scheduler.now());
+}
+
+Task raiseError(vector<int>& log) {
+    co_await yield(1);
+    log.push_back(-1);
+    throw runtime_error("task failed");
+}
+
+struct DestroyCounter {
+    int* count;
+    ~DestroyCounter() { (*count)++; }
+};
+
+Task waitForever(int* destroyed) {
+    DestroyCounter counter{destroyed};
+    co_await suspend_always();
+}
+#endif
+
+int main() {
+    vector<Test> testSuite;
+    addHeapTests<FibHeap,FibInt>(testSuite, "FibonacciHeap");
+    addHeapTests<PairingHeap<int,char>,PairingHeap<int,int>>(testSuite, "PairingHeap");
+    addHeapTests<RankPairingHeap<int,char>,RankPairingHeap<int,int>>(testSuite, "RankPairingHeap");
+    addHeapTests<CoalescingHeap<int,char>,CoalescingHeap<int,int>>(testSuite, "CoalescingHeap");
+
+    Test engineTests[] = {
+        {"Shift all keys", []() {
+            FibHeap h;
+
+            h.insert(10, 'A');
+            h.insert(20, 'B');
+            h.insert(30, 'C');
+
+            h.shiftAllKeys(-15);
+            AssertEquals(-5, h.getMinKey());
+
+            //New keys are compared with the shifted keys
+            h.insert(0, 'D');
+            AssertTrue(h.decreaseKey('C', -10));
+            AssertFalse(h.decreaseKey('B', 5));
+
+            AssertEquals('C', h.extractMin());
+            AssertEquals('A', h.extractMin());
+            AssertEquals(0, h.getMinKey());
+            AssertEquals('D', h.extractMin());
+            AssertEquals(5, h.getMinKey());
+            AssertEquals('B', h.extractMin());
+            TestPassed;
+        }},
+        {"Shift all keys with meld and copy", []() {
+            FibHeap h;
+            FibHeap h2;
+
+            h.insert(10, 'A');
+            h.insert(40, 'D');
+            h.shiftAllKeys(5);
+
+            h2.insert(20, 'B');
+            h2.insert(30, 'C');
+            h2.shiftAllKeys(-10);
+
+            FibHeap h3 = h2;
+            h.meld(&h2);
+            AssertEquals(10, h.getMinKey());
+
+            AssertEquals('B', h.extractMin());
+            AssertEquals('A', h.extractMin());
+            AssertEquals(20, h.getMinKey());
+            AssertEquals('C', h.extractMin());
+            AssertEquals('D', h.extractMin());
+
+            AssertEquals(10, h3.getMinKey());
+            AssertEquals('B', h3.extractMin());
+            TestPassed;
+        }},
+        {"Shift all keys beyond the offset limit", []() {
+            FibHeap h;
+
+            for (int i = 0; i < 100; i++) {
+                h.insert(i, 'A' + (i % 26));
+                h.shiftAllKeys(-10000000);
+            }
+
+            AssertEquals(-1000000000, h.getMinKey());
+            AssertEquals('A', h.extractMin());
+
+            //The offset was folded into the stored keys
+            h.insert(2000000000, 'Z');
+
+            for (int i = 1; i < 100; i++) {
+                AssertEquals(i - 10000000 * (100 - i), h.getMinKey());
+                AssertEquals('A' + (i % 26), h.extractMin());
+            }
+
+            AssertEquals(2000000000, h.getMinKey());
+            AssertEquals('Z', h.extractMin());
+            TestPassed;
+        }},
+        {"Insert large keys after a large negative shift", []() {
+            FibonacciHeap<int,int> h;
+            h.insert(0, 1);
+            h.shiftAllKeys(-1000000000);
+            h.insert(1500000000, 2);
+            h.insert(-2000000000, 3);
+
+            AssertEquals(-2000000000, h.getMinKey());
+            AssertEquals(3, h.extractMin());
+            AssertEquals(-1000000000, h.getMinKey());
+            AssertEquals(1, h.extractMin());
+            AssertEquals(1500000000, h.getMinKey());
+
+            //Updates and batches translate the keys with the same checks
+            auto handle = h.insert(5, 4);
+            h.shiftAllKeys(-600000000);
+            AssertTrue(h.updateKey(handle, 2000000000));
+            AssertEquals(900000000, h.getMinKey());
+
+            vector<FibonacciHeap<int,int>::Result> results;
+            FibonacciHeap<int,int>::Operation ops[] = {
+                {FibonacciHeap<int,int>::INSERT, 2100000000, 5},
+                {FibonacciHeap<int,int>::DECREASE_KEY, -2100000000, 4}
+            };
+
+            h.shiftAllKeys(-500000000);
+            h.applyBatch(ops, 2, results);
+            AssertTrue(results[1].success);
+
+            AssertEquals(4, h.extractMin());
+            AssertEquals(400000000, h.getMinKey());
+            AssertEquals(2, h.extractMin());
+            AssertEquals(2100000000, h.getMinKey());
+            AssertEquals(5, h.extractMin());
+            TestPassed;
+        }},
+        {"Reject shifts beyond the key range", []() {
+            FibonacciHeap<int,int> h;
+            h.insert(INT_MAX - 10, 1);
+            h.insert(INT_MIN + 10, 2);
+            h.insert(0, 3);
+
+            //The folding would clamp the keys to ties
+            AssertFalse(h.shiftAllKeys(100));
+            AssertFalse(h.shiftAllKeys(-100));
+            AssertFalse(h.shiftAllKeys(INT_MAX));
+            AssertTrue(h.shiftAllKeys(10));
+            AssertTrue(h.shiftAllKeys(-20));
+            AssertEquals(INT_MIN, h.getMinKey());
+            AssertEquals(2, h.extractMin());
+
+            //The bound of a removed key is replaced by the largest key
+            AssertEquals(-10, h.getMinKey());
+            AssertTrue(h.remove(1));
+            AssertTrue(h.shiftAllKeys(INT_MAX - 100));
+            AssertEquals(INT_MAX - 110, h.getMinKey());
+
+            h.insert(INT_MAX - 105, 4);
+            AssertFalse(h.shiftAllKeys(106));
+            AssertTrue(h.shiftAllKeys(105));
+            AssertEquals(3, h.extractMin());
+            AssertEquals(INT_MAX, h.getMinKey());
+            AssertEquals(4, h.extractMin());
+            AssertTrue(h.isEmpty());
+            AssertTrue(h.shiftAllKeys(INT_MIN));
+            TestPassed;
+        }},
+        {"Parallel insert with per-thread heaps", []() {
+            vector<pair<int,int>> items(20000);
+
+            for (unsigned int i = 0; i < items.size(); i++) {
+                items[i] = make_pair(i, i);
+            }
+
+            random_shuffle(items.begin(), items.end());
+
+            for (bool consolidateTrees : {false, true}) {
+                FibInt h;
+                h.insert(-1, -1);
+                h.insertParallel(items.data(), items.size(), 4, consolidateTrees);
+
+                AssertEquals(-1, h.extractMin());
+
+                for (unsigned int i = 0; i < items.size(); i++) {
+                    AssertEquals((int)i, h.extractMin());
+                }
+
+                AssertTrue(h.isEmpty());
+            }
+
+            TestPassed;
+        }},
+        {"Deep trees on a small stack", []() {
+            return smallStackTest([]() {
+                FibInt* h = new FibInt();
+                const int depth = 2000;
+
+                //Every round extends a single path by one node
+                for (int i = 1; i <= depth; i++) {
+                    int key = -3 * i;
+                    h->insert(key - 2, key - 2);
+                    h->insert(key - 1, key - 1);
+                    h->insert(key, key);
+                    h->extractMin();
+                    h->remove(key);
+                }
+
+                FibInt* copy = new FibInt(*h);
+                long sum = 0;
+                int count = 0;
+
+                copy->forEach([&](int key, int value) {
+                    sum += key - value;
+                    count++;
+                });
+
+                AssertEquals(depth, count);
+                AssertEquals(0, sum);
+
+                //Search the deepest node
+                AssertTrue(h->decreaseKey(-4, -10 * depth));
+                AssertEquals(-4, h->extractMin());
+
+                delete copy;
+                delete h;
+                TestPassed;
+            }, 32 * 1024);
+        }},
+        {"Sampled invariant checks", []() {
+            unsigned int interval = getInvariantSampling();
+            FuzzConfig config;
+            config.maxSize = 20000;
+
+            vector<FuzzOp> ops;
+            string error;
+            bool passed = true;
+
+            //Only the touched nodes are checked in debug builds
+            setInvariantSampling(0);
+            AssertEquals(0u, getInvariantSampling());
+            passed &= fuzzRandom<FibInt>(50000, 11, config, ops, error);
+
+            setInvariantSampling(5000);
+            passed &= fuzzRandom<FibInt>(50000, 12, config, ops, error);
+
+            setInvariantSampling(interval);
+            AssertTrue(passed);
+            TestPassed;
+        }},
+        {"Large heaps against the reference queue", []() {
+            //Full invariant checks of debug builds are quadratic at this size
+            unsigned int interval = getInvariantSampling();
+            setInvariantSampling(50000);
+
+            bool passed = randomTest<FibInt>(200000, 200000, 80, 28461937);
+
+            //The heaps grow far beyond the default size limit of the fuzzer
+            vector<FuzzOp> ops;
+            string error;
+            passed &= fuzzRandom<FibInt>(150000, 21, FuzzConfig::largeHeaps(), ops, error);
+
+            setInvariantSampling(interval);
+            AssertTrue(passed);
+            TestPassed;
+        }},
+        {"Minimize a failing fuzzer trace", []() {
+            FuzzConfig config;
+            config.meld = 10;
+
+            vector<FuzzOp> ops;
+            string error;
+
+            AssertFalse(fuzzRandom<LossyMeldHeap>(100000, 7, config, ops, error));
+            vector<FuzzOp> minimized = fuzzMinimize<LossyMeldHeap>(ops, config.heaps);
+
+            //Insert into one heap, meld it and observe the other heap
+            AssertEquals(3u, minimized.size());
+            AssertTrue(minimized[0].type == FUZZ_INSERT);
+            AssertTrue(minimized[1].type == FUZZ_MELD);
+
+            DifferentialFuzzer<FibInt> fuzzer(config.heaps);
+            AssertEquals(minimized.size(), fuzzer.run(minimized, error));
+            TestPassed;
+        }},
+        {"Record and replay a trace", []() {
+            stringstream stream;
+            TraceWriter<int,int> writer(stream);
+            TracedHeap<int,int> a(&writer);
+            TracedHeap<int,int,PairingHeap> b(&writer);
+            vector<int> expected;
+
+            for (int i = 0; i < 100; i++) {
+                a.insert((i * 37) % 101, i);
+            }
+
+            a.decreaseKey(50, -1);
+            a.remove(10);
+            expected.push_back(a.extractMin());
+            expected.push_back(a.extractMin());
+
+            AssertEquals(104u, writer.size());
+
+            //Replay the operations on new heaps
+            TraceReader<int,int> reader(stream);
+            TraceRecord<int,int> rec;
+            FibInt replayed;
+            vector<int> extracted;
+            int count = 0;
+
+            AssertTrue(reader.isValid());
+
+            while (reader.read(rec)) {
+                AssertEquals(0u, rec.heap);
+
+                switch (rec.op) {
+                    case TRACE_INSERT: replayed.insert(rec.key, rec.value); break;
+                    case TRACE_EXTRACT_MIN: extracted.push_back(replayed.extractMin()); break;
+                    case TRACE_DECREASE_KEY: replayed.decreaseKey(rec.value, rec.key); break;
+                    case TRACE_REMOVE: replayed.remove(rec.value); break;
+                    case TRACE_MELD: return false;
+                }
+
+                count++;
+            }
+
+            AssertEquals(104, count);
+            AssertTrue(expected == extracted);
+            AssertEquals(a.getMin(), replayed.getMin());
+
+            //Melds refer to the other heap by its number
+            stringstream meldStream;
+            TraceWriter<int,int> meldWriter(meldStream);
+            TracedHeap<int,int> c(&meldWriter);
+            TracedHeap<int,int> d(&meldWriter);
+
+            d.insert(1, 2);
+            c.meld(&d);
+            AssertEquals(2, c.extractMin());
+
+            TraceReader<int,int> meldReader(meldStream);
+            AssertTrue(meldReader.read(rec));
+            AssertEquals(1u, rec.heap);
+            AssertTrue(meldReader.read(rec));
+            AssertTrue(rec.op == TRACE_MELD);
+            AssertEquals(0u, rec.heap);
+            AssertEquals(1u, rec.other);
+
+            //Wrong key or value sizes are rejected
+            stringstream charStream;
+            TraceWriter<int,char> charWriter(charStream);
+            TraceReader<int,int> wrongReader(charStream);
+            AssertFalse(wrongReader.isValid());
+
+            TestPassed;
+        }},
+        {"Copy-on-write snapshots", []() {
+            FibInt h;
+
+            for (int i = 0; i < 100; i++) {
+                h.insert(i, i);
+            }
+
+            h.extractMin();
+            h.decreaseKey(50, -1);
+
+            FibInt snapshot = h.snapshot();
+            FibInt second = snapshot.snapshot();
+            AssertTrue(h.isShared() && snapshot.isShared() && second.isShared());
+            AssertTrue(h.sharedBytes() > 0);
+            AssertEquals(h.sharedBytes(), snapshot.sharedBytes());
+
+            //The first change copies the forest for the changed heap only
+            h.insert(-5, 1000);
+            h.decreaseKey(70, -2);
+            AssertFalse(h.isShared());
+            AssertTrue(snapshot.isShared());
+
+            AssertEquals(1000, h.extractMin());
+            AssertEquals(70, h.extractMin());
+            AssertEquals(50, snapshot.extractMin());
+            AssertEquals(1, snapshot.extractMin());
+            AssertEquals(50, second.getMin());
+
+            //Assigning a snapshot to an existing heap shares the forest as well
+            FibInt assigned;
+            assigned.insert(1, 1);
+            assigned = snapshot.snapshot();
+            AssertTrue(assigned.isShared());
+            AssertEquals(snapshot.sharedBytes(), assigned.sharedBytes());
+            AssertEquals(snapshot.size(), assigned.size());
+            AssertEquals(snapshot.getMin(), assigned.getMin());
+
+            //The last holder takes the nodes back without a copy
+            FibInt* single = new FibInt();
+            single->insert(3, 3);
+            single->insert(2, 2);
+
+            {
+                FibInt released = single->snapshot();
+                AssertEquals(2, released.getMin());
+            }
+
+            size_t bytes = single->sharedBytes();
+            AssertTrue(bytes > 0);
+            AssertEquals(2, single->extractMin());
+            AssertFalse(single->isShared());
+            delete single;
+
+            //The remaining elements are unchanged
+            vector<int> values;
+            second.forEach([&values](int, int value) {
+                values.push_back(value);
+            });
+
+            AssertEquals(99u, values.size());
+
+            for (int i = 0; i < 98; i++) {
+                second.extractMin();
+            }
+
+            AssertEquals(99, second.extractMin());
+            AssertTrue(second.isEmpty());
+            TestPassed;
+        }},
+        {"Read a snapshot on another thread", []() {
+            FibInt h;
+
+            for (int i = 0; i < 20000; i++) {
+                h.insert(i, i);
+            }
+
+            h.extractMin();
+
+            for (int round = 0; round < 20; round++) {
+                FibInt* snapshot = new FibInt(h.snapshot());
+                long long sum = 0;
+                int first = -1;
+
+                //The reader releases the snapshot while the heap is changed
+                thread reader([snapshot, &sum, &first]() {
+                    snapshot->forEach([&sum](int, int value) {
+                        sum += value;
+                    });
+
+                    first = snapshot->getMin();
+                    delete snapshot;
+                });
+
+                for (int i = 0; i < 100; i++) {
+                    h.insert(-1 - i - 100 * round, 0);
+                    h.extractMin();
+                }
+
+                reader.join();
+                AssertEquals(round + 1, first);
+                AssertEquals(20000LL * 19999 / 2 - (long long)round * (round + 1) / 2, sum);
+                h.extractMin();
+            }
+
+            AssertEquals(21, h.getMin());
+            AssertFalse(h.isShared());
+            TestPassed;
+        }},
+        {"Remove next to the smallest possible key", []() {
+            FibonacciHeap<int,int> h;
+            h.insert(INT_MIN, 1);
+            auto handle = h.insert(5, 2);
+            h.insert(7, 3);
+
+            AssertTrue(h.remove(handle));
+            AssertEquals(2u, h.size());
+            AssertEquals(INT_MIN, h.getMinKey());
+            AssertEquals(1, h.extractMin());
+            AssertEquals(7, h.getMinKey());
+
+            //Removal below a linked parent and of the minimum by value
+            for (int i = 0; i < 100; i++) {
+                h.insert(INT_MIN + i, 10 + i);
+            }
+
+            h.extractMin();
+            AssertTrue(h.remove(50));
+            AssertTrue(h.remove(11));
+            AssertFalse(h.remove(2));
+            AssertEquals(98u, h.size());
+
+            for (int i = 2; i < 100; i++) {
+                if (i != 40) {
+                    AssertEquals(10 + i, h.extractMin());
+                }
+            }
+
+            AssertEquals(3, h.extractMin());
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Handles and bounded extraction", []() {
+            FibInt h;
+            vector<FibInt::Handle> handles;
+
+            for (int i = 0; i < 100; i++) {
+                handles.push_back(h.insert(i, i));
+            }
+
+            h.extractMin();
+            AssertFalse(FibInt::Handle().isValid());
+            AssertTrue(handles[10].isValid());
+            AssertEquals(10, h.getKey(handles[10]));
+            AssertEquals(10, h.getValue(handles[10]));
+
+            //Decrease and remove without a search for the value
+            AssertTrue(h.decreaseKey(handles[80], -3));
+            AssertFalse(h.decreaseKey(handles[81], 90));
+            AssertTrue(h.remove(handles[20]));
+            AssertEquals(-3, h.getKey(handles[80]));
+
+            //All elements up to the bound in ascending order
+            vector<pair<int,int>> out;
+            AssertEquals(10u, h.extractUpTo(9, out));
+            AssertEquals(-3, out[0].first);
+            AssertEquals(80, out[0].second);
+
+            for (int i = 1; i < 10; i++) {
+                AssertEquals(i, out[i].first);
+            }
+
+            AssertEquals(0u, h.extractUpTo(9, out));
+            AssertEquals(10, h.getMinKey());
+
+            for (int i = 10; i < 100; i++) {
+                if (i != 20 && i != 80) {
+                    AssertEquals(i, h.extractMin());
+                }
+            }
+
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Timer queue with exact deadlines", []() {
+            TimerQueue<long long,int> timers;
+            vector<TimerQueue<long long,int>::Token> tokens;
+
+            for (int i = 0; i < 1000; i++) {
+                tokens.push_back(timers.schedule((i * 7919) % 1000, i));
+            }
+
+            //Most timers are cancelled, which rebuilds the heap
+            for (int i = 0; i < 1000; i++) {
+                if (i % 10 != 0) {
+                    AssertTrue(timers.cancel(tokens[i]));
+                }
+            }
+
+            AssertFalse(timers.cancel(tokens[1]));
+            AssertFalse(timers.cancel(TimerQueue<long long,int>::Token()));
+            AssertEquals(100u, timers.size());
+
+            //An earlier deadline keeps the token
+            AssertTrue(timers.reschedule(tokens[10], -1));
+            AssertTrue(timers.reschedule(tokens[20], 2000));
+
+            vector<pair<long long,int>> fired;
+            timers.popExpired(499, back_inserter(fired));
+            AssertEquals(-1, fired[0].first);
+            AssertEquals(10, fired[0].second);
+
+            for (size_t i = 1; i < fired.size(); i++) {
+                AssertTrue(fired[i - 1].first <= fired[i].first);
+                AssertTrue(fired[i].first <= 499);
+                AssertEquals(0, fired[i].second % 10);
+            }
+
+            //Tokens of fired timers are stale after the slot is reused
+            AssertFalse(timers.cancel(tokens[10]));
+            TimerQueue<long long,int>::Token reused = timers.schedule(100, -7);
+            AssertFalse(timers.cancel(tokens[10]));
+
+            size_t before = fired.size();
+            AssertEquals(100u - before + 1, timers.size());
+            timers.popExpired(1999, back_inserter(fired));
+            AssertEquals(-7, fired[before].second);
+            AssertFalse(timers.cancel(reused));
+
+            timers.popExpired(2000, back_inserter(fired));
+            AssertEquals(20, fired.back().second);
+            AssertEquals(101u, fired.size());
+            AssertTrue(timers.isEmpty());
+            TestPassed;
+        }},
+        {"Timer queue with buckets", []() {
+            TimerQueue<int,int> timers(10);
+            vector<TimerQueue<int,int>::Token> tokens;
+
+            for (int i = 0; i < 100; i++) {
+                tokens.push_back(timers.schedule(99 - i, i));
+            }
+
+            //Deadlines are rounded up to the resolution
+            AssertEquals(10, timers.getResolution());
+            AssertEquals(0, timers.nextDeadline());
+
+            TimerQueue<int,int> rounded(10);
+            rounded.schedule(101, 0);
+            AssertEquals(110, rounded.nextDeadline());
+
+            for (int i = 0; i < 100; i += 2) {
+                AssertTrue(timers.cancel(tokens[i]));
+            }
+
+            AssertFalse(timers.cancel(tokens[0]));
+            AssertEquals(50u, timers.size());
+
+            vector<pair<int,int>> fired;
+            timers.popExpired(25, back_inserter(fired));
+            AssertEquals(11u, fired.size());
+
+            for (size_t i = 0; i < fired.size(); i++) {
+                AssertEquals(2 * (int)i, fired[i].first);
+                AssertEquals(99 - 2 * (int)i, fired[i].second);
+            }
+
+            //Moving a timer to another bucket
+            AssertTrue(timers.reschedule(tokens[1], 5));
+            fired.clear();
+            timers.popExpired(10, back_inserter(fired));
+            AssertEquals(1u, fired.size());
+            AssertEquals(1, fired[0].second);
+
+            fired.clear();
+            timers.popExpired(100, back_inserter(fired));
+            AssertEquals(38u, fired.size());
+            AssertTrue(timers.isEmpty());
+            TestPassed;
+        }},
+        {"Coalesce equal keys", []() {
+            CoalescingHeap<int,int> h;
+
+            //Ten keys with hundred values each
+            for (int i = 0; i < 1000; i++) {
+                h.insert((i * 7) % 10, i);
+            }
+
+            AssertEquals(1000u, h.size());
+            AssertEquals(10u, h.keyCount());
+
+            //Values of a key are extracted in insertion order
+            AssertEquals(0, h.getMinKey());
+            AssertEquals(0, h.extractMin());
+            AssertEquals(10, h.extractMin());
+
+            //Moving a value to another key and removing a whole key
+            AssertTrue(h.decreaseKey(999, -1));
+            AssertFalse(h.decreaseKey(998, 7));
+            AssertFalse(h.remove(10));
+
+            for (int i = 0; i < 1000; i++) {
+                if ((i * 7) % 10 == 4) {
+                    AssertTrue(h.remove(i));
+                }
+            }
+
+            AssertEquals(898u, h.size());
+            AssertEquals(999, h.extractMin());
+
+            CoalescingHeap<int,int> other;
+            other.insert(0, 1000);
+            other.insert(50, 1001);
+            h.meld(&other);
+            AssertTrue(other.isEmpty());
+
+            int lastKey = -1;
+            vector<int> zeros;
+
+            while (!h.isEmpty()) {
+                int key = h.getMinKey();
+                int value = h.extractMin();
+                AssertTrue(lastKey <= key);
+                AssertTrue(key != 4);
+                lastKey = key;
+
+                if (key == 0) {
+                    zeros.push_back(value);
+                }
+            }
+
+            AssertEquals(99u, zeros.size());
+            AssertEquals(1000, zeros.back());
+            AssertEquals(50, lastKey);
+            AssertEquals(0u, h.keyCount());
+            TestPassed;
+        }},
+        {"Coalesce a key that never drains", []() {
+            CoalescingHeap<int,int> h;
+
+            //The bucket of the key is compacted while it keeps values
+            for (int i = 0; i < 10000; i++) {
+                h.insert(5, 2 * i);
+                h.insert(5, 2 * i + 1);
+                AssertEquals(i, h.extractMin());
+            }
+
+            AssertEquals(10000u, h.size());
+            AssertEquals(1u, h.keyCount());
+            AssertTrue(h.remove(19999));
+            AssertTrue(h.decreaseKey(19998, 4));
+            AssertEquals(19998, h.extractMin());
+
+            for (int i = 10000; i < 19998; i++) {
+                AssertEquals(i, h.extractMin());
+            }
+
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Memory usage and compaction", []() {
+            FibInt h;
+            AssertEquals(0u, h.size());
+            size_t emptyBytes = h.memoryUsage();
+
+            for (int i = 0; i < 20000; i++) {
+                h.insert((i * 7919) % 20000, (i * 7919) % 20000);
+            }
+
+            //Long churn leaves most of the slab space unused
+            for (int i = 0; i < 19000; i++) {
+                h.extractMin();
+            }
+
+            h.decreaseKey(19999, -1);
+            AssertEquals(1000u, h.size());
+
+            size_t before = h.memoryUsage();
+            h.compact();
+            size_t after = h.memoryUsage();
+
+            AssertTrue(after > emptyBytes);
+            AssertTrue(after * 10 < before);
+            AssertEquals(1000u, h.size());
+
+            //Shared nodes are copied and the snapshot stays unchanged
+            FibInt snapshot = h.snapshot();
+            h.compact();
+            AssertFalse(h.isShared());
+            AssertEquals(after, h.memoryUsage());
+            AssertEquals(19999, snapshot.getMin());
+
+            FibInt reader = snapshot;
+            AssertEquals(19999, reader.extractMin());
+            AssertEquals(19000, reader.extractMin());
+            AssertEquals(1000u, snapshot.size());
+
+            AssertEquals(19999, h.extractMin());
+
+            for (int key = 19000; key < 19999; key++) {
+                AssertEquals(key, h.getMinKey());
+                AssertEquals(key, h.extractMin());
+            }
+
+            AssertTrue(h.isEmpty());
+            h.compact();
+            AssertEquals(emptyBytes, h.memoryUsage());
+            TestPassed;
+        }},
+        {"Degree bound for 64-bit sizes", []() {
+            //Heaps with more than 2^32 nodes have trees of a higher degree
+            AssertEquals(45u, fibheapMaxDegree(~0U));
+            AssertEquals(47u, fibheapMaxDegree(1ULL << 33));
+            AssertEquals(91u, fibheapMaxDegree(~0ULL));
+
+            //A tree of degree d has at least F(d+2) nodes
+            AssertEquals(0u, fibheapMaxDegree(1));
+            AssertEquals(1u, fibheapMaxDegree(2));
+            AssertEquals(2u, fibheapMaxDegree(4));
+            AssertEquals(3u, fibheapMaxDegree(7));
+            AssertEquals(4u, fibheapMaxDegree(12));
+            TestPassed;
+        }},
+        {"Cold value storage", []() {
+            typedef FibonacciHeap<int,Payload<256,true>> ColdHeap;
+            typedef FibonacciHeap<int,Payload<256,false>> InlineHeap;
+            ColdHeap cold;
+            InlineHeap hot;
+            vector<ColdHeap::Handle> handles;
+
+            for (int i = 0; i < 1000; i++) {
+                handles.push_back(cold.insert((i * 7919) % 1000, Payload<256,true>(i)));
+                hot.insert((i * 7919) % 1000, Payload<256,false>(i));
+            }
+
+            //Both layouts keep the same values
+            AssertEquals(hot.getMin().id, cold.getMin().id);
+            AssertEquals(0u, cold.extractMin().id);
+            AssertTrue(cold.decreaseKey(handles[500], -1));
+            AssertEquals(500u, cold.getValue(handles[500]).id);
+            AssertTrue(cold.decreaseKey(Payload<256,true>(7), -2));
+            AssertTrue(cold.remove(Payload<256,true>(8)));
+
+            //Copies, snapshots, melds and the compaction move the cold values
+            ColdHeap copy(cold);
+            ColdHeap snapshot = cold.snapshot();
+            ColdHeap other;
+            other.insert(-3, Payload<256,true>(1000));
+            cold.meld(&other);
+            cold.compact();
+
+            AssertEquals(1000u, cold.extractMin().id);
+            AssertEquals(7u, cold.extractMin().id);
+            AssertEquals(7u, copy.extractMin().id);
+            AssertEquals(7u, snapshot.getMin().id);
+
+            vector<pair<int,Payload<256,true>>> out;
+            cold.extractUpTo(10, out);
+            AssertEquals(11u, out.size());
+            AssertEquals(500u, out[0].second.id);
+            AssertEquals(997u, cold.size() + out.size());
+
+            while (!cold.isEmpty()) {
+                Payload<256,true> value = cold.extractMin();
+                AssertEquals((char)(value.id & 0xff), value.data[200]);
+            }
+
+            TestPassed;
+        }},
+        {"Update keys through handles", []() {
+            for (bool lazy : {false, true}) {
+                FibInt h;
+                h.setLazy(lazy);
+                vector<FibInt::Handle> handles;
+                vector<int> keys;
+
+                for (int i = 0; i < 2000; i++) {
+                    keys.push_back((i * 7919) % 2000);
+                    handles.push_back(h.insert(keys[i], i));
+                }
+
+                //Build trees with children and marked nodes
+                h.extractMin();
+                keys[0] = INT_MAX;
+                srand(11);
+
+                for (int i = 0; i < 5000; i++) {
+                    //Increases of the minimum and random changes of other nodes
+                    int target = (i % 7 == 0) ? h.getMin() : 1 + rand() % 1999;
+
+                    if (keys[target] == INT_MAX) {
+                        continue;
+                    }
+
+                    int key = (i % 7 == 0) ? keys[target] + 1 + rand() % 100 : rand() % 4000 - 1000;
+                    AssertTrue(h.updateKey(handles[target], key));
+                    AssertEquals(key, h.getKey(handles[target]));
+                    keys[target] = key;
+
+                    if (i % 10 == 0) {
+                        int value = h.extractMin();
+                        AssertEquals(*min_element(keys.begin(), keys.end()), keys[value]);
+                        keys[value] = INT_MAX;
+                    }
+                }
+
+                AssertFalse(h.updateKey(FibInt::Handle(), 1));
+                int lastKey = INT_MIN;
+
+                while (!h.isEmpty()) {
+                    int value = h.extractMin();
+                    AssertTrue(lastKey <= keys[value]);
+                    lastKey = keys[value];
+                    keys[value] = INT_MAX;
+                }
+
+                AssertEquals(INT_MAX, *min_element(keys.begin(), keys.end()));
+            }
+
+            TestPassed;
+        }},
+        {"Shortest paths and spanning trees", []() {
+            //Small graph from the DIMACS format
+            stringstream dimacs("c example\np sp 5 7\na 1 2 4\na 1 3 1\na 3 2 2\na 2 4 1\na 3 4 5\na 4 5 3\na 5 1 1\n");
+            CsrGraph small;
+            string error;
+            AssertTrue(loadDimacs(dimacs, small, error));
+            AssertEquals(5u, small.vertexCount());
+            AssertEquals(7u, small.edgeCount());
+
+            ShortestPaths paths = dijkstra(small, 0);
+            long long expected[] = {0, 3, 1, 4, 7};
+
+            for (uint32_t v = 0; v < 5; v++) {
+                AssertEquals(expected[v], paths.distance[v]);
+            }
+
+            AssertEquals(2u, paths.parent[1]);
+            AssertEquals(ShortestPaths::none, paths.parent[0]);
+
+            stringstream invalid("p sp 2 1\na 1 3 1\n");
+            AssertFalse(loadDimacs(invalid, small, error));
+
+            stringstream negative("p sp 2 1\na 1 2 -1\n");
+            AssertFalse(loadDimacs(negative, small, error));
+            AssertEquals(string("negative weight in line 2"), error);
+
+            stringstream negativeList("0 1 4\n1 0 -4\n");
+            AssertFalse(loadEdgeList(negativeList, small, error));
+            AssertEquals(string("negative weight in line 2"), error);
+            AssertEquals(0u, randomGraph(0, 4, 100, 5).vertexCount());
+
+            //Engines with and without handles find the same distances
+            CsrGraph random = randomGraph(2000, 4, 100, 5);
+            ShortestPaths fib = dijkstra(random, 7);
+            ShortestPaths pairing = dijkstra<PairingHeap>(random, 7);
+            AssertTrue(fib.distance == pairing.distance);
+
+            //A* with the manhattan distance on a grid with weights of at least one
+            const uint32_t width = 60;
+            CsrGraph grid = gridGraph(width, 9, 3);
+            ShortestPaths gridPaths = dijkstra(grid, 0);
+            uint32_t target = width * width - 1;
+
+            auto manhattan = [target](uint32_t v) {
+                return (long long)(abs((int)(v % width) - (int)(target % width)) +
+                                   abs((int)(v / width) - (int)(target / width)));
+            };
+
+            vector<uint32_t> path;
+            AssertEquals(gridPaths.distance[target], astar(grid, 0, target, manhattan, &path));
+            AssertEquals(0u, path.front());
+            AssertEquals(target, path.back());
+            AssertEquals(gridPaths.distance[target], astar<RankPairingHeap>(grid, 0, target, manhattan));
+
+            //Prim against Kruskal with a union find
+            stringstream edgeList("# triangle and a separate edge\n0 1 3\n1 2 1\n0 2 2\n3 4\n");
+            CsrGraph forest;
+            AssertTrue(loadEdgeList(edgeList, forest, error, true));
+            vector<uint32_t> parent;
+            AssertEquals(4, prim(forest, &parent));
+            AssertEquals(ShortestPaths::none, parent[3]);
+            AssertEquals(3u, parent[4]);
+
+            vector<GraphEdge> edges;
+
+            for (uint32_t v = 0; v < grid.vertexCount(); v++) {
+                for (size_t e = grid.edgeBegin(v); e < grid.edgeEnd(v); e++) {
+                    edges.push_back({v, grid.target(e), grid.weight(e)});
+                }
+            }
+
+            sort(edges.begin(), edges.end(), [](const GraphEdge& a, const GraphEdge& b) {
+                return a.weight < b.weight;
+            });
+
+            vector<uint32_t> sets(grid.vertexCount());
+            iota(sets.begin(), sets.end(), 0);
+            long long kruskal = 0;
+
+            auto findSet = [&sets](uint32_t v) {
+                while (sets[v] != v) {
+                    v = sets[v] = sets[sets[v]];
+                }
+
+                return v;
+            };
+
+            for (const GraphEdge& edge : edges) {
+                uint32_t a = findSet(edge.source);
+                uint32_t b = findSet(edge.target);
+
+                if (a != b) {
+                    sets[a] = b;
+                    kruskal += edge.weight;
+                }
+            }
+
+            AssertEquals(kruskal, prim(grid));
+            AssertEquals(kruskal, prim<PairingHeap>(grid));
+            TestPassed;
+        }},
+#ifdef __cpp_impl_coroutine
+        {"Coroutine scheduler", []() {
+            Scheduler scheduler(true);
+            vector<int> log;
+
+            //Equal priorities run round robin, lower priorities first
+            scheduler.spawn(logRounds(log, 1, 2), 3);
+            scheduler.spawn(logRounds(log, 2, 2), 3);
+            scheduler.spawn(logRounds(log, 0, 2), 1);
+            scheduler.run();
+
+            vector<int> expected = {0, 0, 1, 2, 1, 2};
+            AssertTrue(log == expected);
+            AssertEquals(0u, scheduler.taskCount());
+
+            //Sleeping tasks wake in the order of their deadlines on the virtual clock
+            vector<long long> wakeups;
+            scheduler.spawn(logAfterSleep(scheduler, wakeups, 300));
+            scheduler.spawn(logAfterSleep(scheduler, wakeups, 100));
+            scheduler.spawn(logAfterSleep(scheduler, wakeups, 200));
+            scheduler.run();
+
+            vector<long long> expectedWakeups = {100, 200, 300};
+            AssertTrue(wakeups == expectedWakeups);
+            AssertEquals(300, scheduler.now());
+
+            //A new priority of a ready task moves it in the queue
+            log.clear();
+            Scheduler::TaskId first = scheduler.spawn(logRounds(log, 1, 1), 10);
+            scheduler.spawn(logRounds(log, 2, 1), 10);
+            Scheduler::TaskId third = scheduler.spawn(logRounds(log, 3, 1), 10);
+            AssertTrue(scheduler.setPriority(third, 0));
+            AssertTrue(scheduler.setPriority(first, 20));
+            scheduler.run();
+
+            expected = {3, 2, 1};
+            AssertTrue(log == expected);
+            AssertFalse(scheduler.setPriority(third, 0));
+
+            //Exceptions of a task reach the caller of run
+            log.clear();
+            scheduler.spawn(raiseError(log));
+            scheduler.spawn(logRounds(log, 5, 2), 2);
+            bool thrown = false;
+
+            try {
+                scheduler.run();
+            } catch (const runtime_error&) {
+                thrown = true;
+            }
+
+            AssertTrue(thrown);
+            scheduler.run();
+            expected = {-1, 5, 5};
+            AssertTrue(log == expected);
+
+            //Tasks that wait for something else are destroyed with the scheduler
+            int destroyed = 0;
+            {
+                Scheduler unfinished;
+                unfinished.spawn(waitForever(&destroyed));
+                unfinished.run();
+                AssertEquals(1u, unfinished.taskCount());
+            }
+            AssertEquals(1, destroyed);
+            TestPassed;
+        }},
+#endif
+        {"Merge sorted inputs", []() {
+            MergeRecord record = {"x 17 -42 y", 10};
+            long long key;
+            AssertTrue(parseMergeKey(record, 2, key));
+            AssertEquals(17, key);
+            AssertTrue(parseMergeKey(record, 3, key));
+            AssertEquals(-42, key);
+            AssertFalse(parseMergeKey(record, 1, key));
+            AssertFalse(parseMergeKey(record, 5, key));
+
+            //Memory inputs with a missing final newline and an empty input
+            const char* a = "1 a\n4 a\n4 b\n9 a";
+            const char* b = "2 b\n3 b\n";
+            FILE* output = tmpfile();
+            vector<MergeInput> inputs(3);
+            inputs[0].openMemory("a", a, strlen(a));
+            inputs[1].openMemory("b", b, strlen(b));
+            inputs[2].openMemory("empty", "", 0);
+
+            string error;
+            size_t records;
+            MergeWriter writer(fileno(output));
+            AssertTrue(kwayMerge(inputs, writer, 1, records, error));
+            AssertEquals(6u, records);
+
+            char merged[64] = {0};
+            AssertEquals(24, pread(fileno(output), merged, sizeof(merged) - 1, 0));
+            AssertEquals(string("1 a\n2 b\n3 b\n4 a\n4 b\n9 a\n"), string(merged));
+            fclose(output);
+
+            //A file read through a buffer smaller than the input and a line longer than the buffer
+            char path[] = "/tmp/fibheap-merge-XXXXXX";
+            int fd = mkstemp(path);
+            AssertTrue(fd >= 0);
+            string content;
+
+            for (int i = 0; i < 2000; i += 2) {
+                content += to_string(i) + " " + string(i == 1000 ? 9000 : 20, 'f') + "\n";
+            }
+
+            AssertEquals((ssize_t)content.size(), write(fd, content.data(), content.size()));
+            close(fd);
+
+            string odd;
+
+            for (int i = 1; i < 2000; i += 2) {
+                odd += to_string(i) + " o\n";
+            }
+
+            for (int map = 0; map < 2; map++) {
+                vector<MergeInput> files(2);
+                AssertTrue(files[0].open(path, map != 0, 4096, error));
+                files[1].openMemory("odd", odd.data(), odd.size());
+
+                output = tmpfile();
+                MergeWriter fileWriter(fileno(output));
+                AssertTrue(kwayMerge(files, fileWriter, 1, records, error));
+                AssertEquals(2000u, records);
+
+                //The keys of the output count up from zero
+                rewind(output);
+                long long expected = 0;
+                char line[10000];
+
+                while (fgets(line, sizeof(line), output) != NULL) {
+                    AssertEquals(expected++, atoll(line));
+                }
+
+                AssertEquals(2000, expected);
+                fclose(output);
+            }
+
+            unlink(path);
+            AssertFalse(MergeInput().open(path, true, 4096, error));
+
+            //Unsorted inputs and missing keys are reported with their line
+            const char* unsorted = "1\n3\n2\n";
+            const char* invalid = "1\nkey\n";
+            int null = open("/dev/null", O_WRONLY);
+            MergeWriter nullWriter(null);
+
+            vector<MergeInput> wrong(1);
+            wrong[0].openMemory("unsorted", unsorted, strlen(unsorted));
+            AssertFalse(kwayMerge(wrong, nullWriter, 1, records, error));
+            AssertEquals(string("unsorted:3: input is not sorted"), error);
+
+            wrong[0].openMemory("invalid", invalid, strlen(invalid));
+            AssertFalse(kwayMerge(wrong, nullWriter, 1, records, error));
+            AssertEquals(string("invalid:2: no integer key in field 1"), error);
+            close(null);
+
+            TestPassed;
+        }},
+        {"Export the heap structure", []() {
+            FibInt h;
+
+            for (int i = 0; i < 64; i++) {
+                h.insert(i, 100 + i);
+            }
+
+            h.extractMin();
+            h.insert(-1, 99);
+            h.shiftAllKeys(1);
+
+            //The consolidated trees have the degrees 0 to 5 and one new root
+            stringstream csv;
+            AssertEquals(64u, h.exportStructure(csv, FibInt::EXPORT_CSV));
+
+            string line;
+            getline(csv, line);
+            AssertEquals(string("id,parent,depth,key,value,degree,marked,min"), line);
+
+            int lines = 0;
+            size_t maxDepth = 0;
+            bool foundMin = false;
+
+            while (getline(csv, line)) {
+                stringstream fields(line);
+                string id, parent, depth, key, value;
+                getline(fields, id, ',');
+                getline(fields, parent, ',');
+                getline(fields, depth, ',');
+                getline(fields, key, ',');
+                getline(fields, value, ',');
+
+                maxDepth = max(maxDepth, (size_t)stoi(depth));
+                AssertEquals(stoi(value) - 99, stoi(key));
+                AssertTrue((parent == "-1") == (depth == "0"));
+                foundMin |= line.substr(line.size() - 2) == ",1";
+                lines++;
+            }
+
+            AssertEquals(64, lines);
+            AssertEquals(5u, maxDepth);
+            AssertTrue(foundMin);
+
+            //Limits for the depth, the number of nodes and the trees
+            FibInt::ExportOptions options;
+            stringstream limited;
+            options.maxDepth = 0;
+            AssertEquals(7u, h.exportStructure(limited, FibInt::EXPORT_DOT, options));
+
+            options.maxDepth = 1;
+            AssertEquals(7u + 15u, h.exportStructure(limited, FibInt::EXPORT_DOT, options));
+
+            options.maxDepth = SIZE_MAX;
+            options.maxNodes = 10;
+            AssertEquals(10u, h.exportStructure(limited, FibInt::EXPORT_JSON, options));
+
+            options.maxNodes = SIZE_MAX;
+            options.treeStride = 100;
+            stringstream json;
+            size_t sampled = h.exportStructure(json, FibInt::EXPORT_JSON, options);
+            AssertTrue(sampled >= 1 && sampled <= 32);
+            AssertEquals(string("{\"offset\":1,"), json.str().substr(0, 12));
+            AssertEquals(string("]}\n"), json.str().substr(json.str().size() - 3));
+
+            //The heap is not changed
+            AssertEquals(99, h.extractMin());
+            AssertEquals(101, h.extractMin());
+            TestPassed;
+        }},
+        {"Peek the k smallest elements", []() {
+            FibInt h;
+            vector<int> keys(1000);
+            iota(keys.begin(), keys.end(), 0);
+            random_shuffle(keys.begin(), keys.end());
+
+            for (int key : keys) {
+                h.insert(key, 2 * key);
+            }
+
+            //Create trees with children and marked nodes
+            h.extractMin();
+            h.decreaseKey(2 * 500, -5);
+            h.shiftAllKeys(10);
+
+            vector<pair<int,int>> top;
+            h.peekK(5, back_inserter(top));
+
+            AssertEquals(5u, top.size());
+            AssertEquals(5, top[0].first);
+            AssertEquals(1000, top[0].second);
+
+            for (int i = 1; i < 5; i++) {
+                AssertEquals(i + 10, top[i].first);
+                AssertEquals(2 * i, top[i].second);
+            }
+
+            //The heap is not changed
+            vector<pair<int,int>> all;
+            h.peekK(5000, back_inserter(all));
+            AssertEquals(999u, all.size());
+
+            for (const pair<int,int>& item : all) {
+                AssertEquals(item.second, h.extractMin());
+            }
+
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Lazy min mode matches the eager mode", []() {
+            FibInt eager;
+            FibInt lazy;
+            lazy.setLazy(true);
+            srand(192837465);
+
+            //Unique keys keep the extraction order independent of the shape
+            vector<int> keys(20000);
+            iota(keys.begin(), keys.end(), 0);
+            random_shuffle(keys.begin(), keys.end());
+
+            for (unsigned int i = 0; i < keys.size(); i++) {
+                eager.insert(keys[i], keys[i]);
+                lazy.insert(keys[i], keys[i]);
+
+                if (rand() % 3 == 0) {
+                    AssertEquals(eager.extractMin(), lazy.extractMin());
+                }
+
+                if (rand() % 10 == 0) {
+                    int target = keys[rand() % (i + 1)];
+                    int newKey = -1 - (int)i;
+                    AssertEquals(eager.decreaseKey(target, newKey), lazy.decreaseKey(target, newKey));
+                }
+
+                if (rand() % 7 == 0) {
+                    const FibInt& constLazy = lazy;
+                    AssertEquals(eager.getMin(), constLazy.getMin());
+                    AssertEquals(eager.getMinKey(), constLazy.getMinKey());
+                }
+            }
+
+            FibInt copy = lazy;
+            lazy.setLazy(false);
+
+            while (!eager.isEmpty()) {
+                int value = eager.extractMin();
+                AssertEquals(value, lazy.extractMin());
+                AssertEquals(value, copy.extractMin());
+            }
+
+            AssertTrue(lazy.isEmpty());
+            AssertTrue(copy.isEmpty());
+            TestPassed;
+        }},
+        {"Batch operations match sequential execution", []() {
+            FibInt seq;
+            FibInt batch;
+            vector<FibInt::Operation> ops;
+            vector<FibInt::Result> results;
+            srand(831746231);
+
+            //Unique keys keep the extraction order independent of the shape
+            int counter = 0;
+
+            for (int round = 0; round < 50; round++) {
+                ops.clear();
+
+                for (int i = 0; i < 200; i++, counter++) {
+                    int r = rand() % 100;
+                    FibInt::Operation op;
+                    op.key = (rand() % 100000) * 10000 + counter;
+                    op.value = (counter == 0) ? 0 : rand() % counter;
+
+                    if (r < 50) {
+                        op.type = FibInt::INSERT;
+                        op.value = counter;
+                    } else if (r < 80) {
+                        op.type = FibInt::DECREASE_KEY;
+                    } else if (r < 95) {
+                        op.type = FibInt::EXTRACT_MIN;
+                    } else {
+                        op.type = FibInt::REMOVE;
+                    }
+
+                    ops.push_back(op);
+                }
+
+                batch.applyBatch(ops.data(), ops.size(), results);
+                AssertEquals(ops.size(), results.size());
+
+                for (unsigned int i = 0; i < ops.size(); i++) {
+                    switch (ops[i].type) {
+                        case FibInt::INSERT:
+                            seq.insert(ops[i].key, ops[i].value);
+                            AssertTrue(results[i].success);
+                            break;
+                        case FibInt::DECREASE_KEY:
+                            AssertEquals(seq.decreaseKey(ops[i].value, ops[i].key), results[i].success);
+                            break;
+                        case FibInt::EXTRACT_MIN:
+                            AssertEquals(!seq.isEmpty(), results[i].success);
+                            AssertEquals(seq.extractMin(), results[i].value);
+                            break;
+                        case FibInt::REMOVE:
+                            AssertEquals(seq.remove(ops[i].value), results[i].success);
+                            break;
+                    }
+                }
+            }
+
+            while (!seq.isEmpty()) {
+                AssertEquals(seq.extractMin(), batch.extractMin());
+            }
+
+            AssertTrue(batch.isEmpty());
+            TestPassed;
+        }},
+        {"Vectorized root key min search", []() {
+            alignas(SIMDMIN_ALIGN) int keys[64];
+            srand(73618231);
+
+            for (int round = 0; round < 1000; round++) {
+                size_t count = SIMDMIN_LANES * (1 + rand() % 8);
+
+                for (size_t i = 0; i < count; i++) {
+                    keys[i] = rand() - RAND_MAX / 2;
+                }
+
+                AssertEquals(minKeyScalar(keys, count), minKey(keys, count));
+            }
+
+            TestPassed;
+        }},
+        {"Vectorized min search in the consolidation", []() {
+            FibonacciHeap<int,int> scalar;
+            FibonacciHeap<int,int> vectorized;
+            vectorized.setVectorMin(true);
+            AssertTrue(vectorized.isVectorMin());
+            srand(51763401);
+
+            //Duplicate keys select the same tree with both searches
+            for (int i = 0; i < 5000; i++) {
+                int key = rand() % 1000;
+                scalar.insert(key, i);
+                vectorized.insert(key, i);
+
+                if (i % 7 == 0) {
+                    AssertEquals(scalar.extractMin(), vectorized.extractMin());
+                }
+            }
+
+            while (!scalar.isEmpty()) {
+                AssertEquals(scalar.getMinKey(), vectorized.getMinKey());
+                AssertEquals(scalar.extractMin(), vectorized.extractMin());
+            }
+
+            AssertTrue(vectorized.isEmpty());
+            TestPassed;
+        }},
+        {"Static heap insert until full", []() {
+            StaticFibHeap* h = new StaticFibHeap();
+            char c = 'A';
+
+            for (int i = 0; i < 64; i++) {
+                AssertTrue(h->insert(64 - i, c + (i % 26)));
+            }
+
+            AssertTrue(h->isFull());
+            AssertFalse(h->insert(0, 'Z'));
+            AssertEquals(64u, h->size());
+
+            //A freed node can be reused
+            AssertEquals(c + (63 % 26), h->extractMin());
+            AssertTrue(h->insert(0, 'z'));
+            AssertEquals('z', h->extractMin());
+
+            delete h;
+            TestPassed;
+        }},
+        {"Static heap decrease key and remove", []() {
+            StaticFibHeap h;
+            char c = 'A';
+
+            for (int i = 1; i < 27; i++, c++) {
+                h.insert(2 * i, c);
+            }
+
+            AssertEquals('A', h.extractMin());
+
+            h.decreaseKey('W', 5);
+            h.decreaseKey('X', 7);
+            AssertTrue(h.remove('C'));
+            AssertFalse(h.remove('a'));
+
+            AssertEquals('B', h.extractMin());
+            AssertEquals('W', h.extractMin());
+            AssertEquals('X', h.extractMin());
+            AssertEquals('D', h.extractMin());
+            TestPassed;
+        }},
+        {"Static heap copy and meld", []() {
+            StaticFibHeap h;
+            StaticFibHeap h2;
+
+            h.insert(3, 'A');
+            h.insert(5, 'C');
+            h2.insert(4, 'B');
+
+            StaticFibHeap h3 = h;
+            AssertTrue(h3.meld(&h2));
+            AssertTrue(h2.isEmpty());
+
+            AssertEquals('A', h3.extractMin());
+            AssertEquals('B', h3.extractMin());
+            AssertEquals('C', h3.extractMin());
+            AssertTrue(h3.isEmpty());
+
+            AssertEquals('A', h.extractMin());
+            AssertEquals('C', h.extractMin());
+            TestPassed;
+        }},
+        {"Static heap meld of consolidated trees", []() {
+            StaticFibInt h;
+            StaticFibInt h2;
+
+            //Both heaps have trees with children and marked nodes
+            for (int i = 0; i < 3000; i++) {
+                h.insert(2 * i, 2 * i);
+                h2.insert(2 * i + 1, 2 * i + 1);
+            }
+
+            h.extractMin();
+            h2.extractMin();
+            h.decreaseKey(1000, -2);
+            h2.decreaseKey(2001, -1);
+
+            AssertTrue(h.meld(&h2));
+            AssertTrue(h2.isEmpty());
+            AssertEquals(5998u, (unsigned int)h.size());
+
+            //The emptied heap can be filled to its capacity again
+            for (int i = 0; i < 8192; i++) {
+                AssertTrue(h2.insert(i, i));
+            }
+
+            AssertFalse(h.meld(&h2));
+            AssertEquals(1000, h.extractMin());
+            AssertEquals(2001, h.extractMin());
+
+            for (int i = 2; i < 6000; i++) {
+                if (i != 1000 && i != 2001) {
+                    AssertEquals(i, h.extractMin());
+                }
+            }
+
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Static heap random with 5000 elements", []() {
+            return randomTest<StaticFibInt>(5000, 5000, 75, 493825932);
+        }},
+        {"Soft heap with small epsilon is exact", []() {
+            SoftHeap<int,int> h(0.000001);
+            vector<int> keys(5000);
+            iota(keys.begin(), keys.end(), 0);
+            random_shuffle(keys.begin(), keys.end());
+
+            for (int key : keys) {
+                h.insert(key, key);
+            }
+
+            for (int i = 0; i < 5000; i++) {
+                AssertEquals(i, h.getMin());
+                AssertEquals(i, h.extractMin());
+            }
+
+            AssertTrue(h.isEmpty());
+            AssertEquals(0, h.corruptedCount());
+            TestPassed;
+        }},
+        {"Soft heap corruption is bounded by epsilon", []() {
+            SoftHeap<int,int> h(0.1);
+            SoftHeap<int,int> h2(0.1);
+            vector<int> keys(20000);
+            iota(keys.begin(), keys.end(), 0);
+            random_shuffle(keys.begin(), keys.end());
+
+            for (unsigned int i = 0; i < keys.size(); i++) {
+                (i % 2 ? h : h2).insert(keys[i], keys[i]);
+            }
+
+            h.meld(&h2);
+            AssertTrue(h2.isEmpty());
+            AssertTrue(h.corruptedCount() <= 2000);
+
+            //Every element is extracted exactly once
+            vector<bool> extracted(keys.size(), false);
+
+            for (unsigned int i = 0; i < keys.size(); i++) {
+                int value = h.extractMin();
+                AssertFalse(extracted[value]);
+                extracted[value] = true;
+                AssertTrue(h.corruptedCount() <= 2000);
+            }
+
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Radix heap decrease key and remove", []() {
+            RadixHeap<int,char> h;
+
+            h.insert(4, 'B');
+            h.insert(6, 'C');
+            h.insert(2, 'A');
+            h.insert(8, 'D');
+            h.insert(9, 'F');
+            h.insert(7, 'E');
+
+            AssertEquals('A', h.getMin());
+            AssertEquals('A', h.extractMin());
+
+            AssertTrue(h.decreaseKey('E', 5));
+            AssertFalse(h.decreaseKey('D', 9));
+            AssertTrue(h.remove('C'));
+            AssertFalse(h.remove('C'));
+
+            AssertEquals('B', h.extractMin());
+            AssertEquals('E', h.extractMin());
+            AssertEquals('D', h.extractMin());
+            AssertEquals('F', h.extractMin());
+            AssertTrue(h.isEmpty());
+            TestPassed;
+        }},
+        {"Monotone random with 5000 elements", []() {
+            return monotoneTest(5000, 100, 193462551);
+        }},
+        {"Radix heap monotone random with 5000 elements", []() {
+            return monotoneTest<RadixInt>(5000, 100, 193462551);
         }}
     };
 
+    testSuite.insert(testSuite.end(), begin(engineTests), end(engineTests));
+
     unsigned int passed = 0;
     unsigned int failed = 0;
 
-    for (unsigned int i = 0; i < sizeof(testSuite)/sizeof(testSuite[0]); i++) {
-        Test t = testSuite[i];
+    for (Test& t : testSuite) {
         cout << "Running Test " << setfill('0') << setw(2) << t.getID() << ": ";
         t.run();
 
@@ -0,0 +1,332 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "pairingheap.h"
+
+template <typename K, typename V>
+void PairingHeap<K,V>::makeHeap() {
+    root = NULL;
+    nodeCount = 0;
+}
+
+template <typename K, typename V>
+PairingHeap<K,V>::PairingHeap() {
+    makeHeap();
+}
+
+template <typename K, typename V>
+PairingHeap<K,V>::PairingHeap(const PairingHeap<K,V>& orig) {
+    makeHeap();
+
+    if (!orig.isEmpty()) {
+        insertTree(orig.root);
+    }
+}
+
+template <typename K, typename V>
+PairingHeap<K,V>& PairingHeap<K,V>::operator=(const PairingHeap<K,V>& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    //Free the current nodes
+    if (!isEmpty()) {
+        freeTree(root);
+        makeHeap();
+    }
+
+    if (!rhs.isEmpty()) {
+        insertTree(rhs.root);
+    }
+
+    return *this;
+}
+
+template <typename K, typename V>
+PairingHeap<K,V>::~PairingHeap() {
+    if (!isEmpty()) {
+        freeTree(root);
+    }
+}
+
+template <typename K, typename V>
+void PairingHeap<K,V>::insertTree(Node* node) {
+    //Sibling lists can be very long so the tree is walked with a stack
+    vector<Node*> stack(1, node);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+
+        insert(curNode->key, curNode->value);
+
+        if (curNode->child != NULL) {
+            stack.push_back(curNode->child);
+        }
+
+        if (curNode->next != NULL) {
+            stack.push_back(curNode->next);
+        }
+    }
+}
+
+template <typename K, typename V>
+void PairingHeap<K,V>::freeTree(Node* node) {
+    vector<Node*> stack(1, node);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+
+        if (curNode->child != NULL) {
+            stack.push_back(curNode->child);
+        }
+
+        if (curNode->next != NULL) {
+            stack.push_back(curNode->next);
+        }
+
+        delete curNode;
+    }
+}
+
+template <typename K, typename V>
+bool PairingHeap<K,V>::isEmpty() const {
+    return root == NULL;
+}
+
+template <typename K, typename V>
+void PairingHeap<K,V>::insert(K key, V value) {
+    Node* node = new Node;
+
+    //Initialize the node values
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+    node->key = key;
+    node->value = value;
+
+    root = link(root, node);
+    nodeCount++;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+}
+
+template <typename K, typename V>
+void PairingHeap<K,V>::meld(PairingHeap<K,V>* other) {
+    if (other != NULL && other != this && !other->isEmpty()) {
+        root = link(root, other->root);
+        nodeCount += other->nodeCount;
+
+        #ifdef DEBUG
+        assert (invariant());
+        #endif
+
+        //Reset the second heap to prevent unexpected side-effects
+        other->makeHeap();
+    }
+}
+
+template <typename K, typename V>
+typename PairingHeap<K,V>::Node* PairingHeap<K,V>::link(Node* a, Node* b) {
+    if (a == NULL) {
+        return b;
+    } else if (b == NULL) {
+        return a;
+    }
+
+    //Make sure that a is the smaller node
+    if (b->key < a->key) {
+        Node* swap = a;
+        a = b;
+        b = swap;
+    }
+
+    //b becomes the first child of a
+    b->prev = a;
+    b->next = a->child;
+
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+
+    a->child = b;
+    return a;
+}
+
+template <typename K, typename V>
+typename PairingHeap<K,V>::Node* PairingHeap<K,V>::mergePairs(Node* first) {
+    pairs.clear();
+    Node* curNode = first;
+
+    //First pass: link the children pairwise from left to right
+    while (curNode != NULL) {
+        Node* a = curNode;
+        Node* b = curNode->next;
+        curNode = (b != NULL) ? b->next : NULL;
+
+        a->prev = a->next = NULL;
+
+        if (b != NULL) {
+            b->prev = b->next = NULL;
+        }
+
+        pairs.push_back(link(a, b));
+    }
+
+    if (pairs.empty()) {
+        return NULL;
+    }
+
+    //Second pass: link the pairs from right to left
+    Node* result = pairs.back();
+
+    for (size_t i = pairs.size() - 1; i > 0; i--) {
+        result = link(pairs[i - 1], result);
+    }
+
+    return result;
+}
+
+template <typename K, typename V>
+V PairingHeap<K,V>::getMin() const {
+    if (root == NULL) {
+        //Empty heap
+        return (V)0;
+    } else {
+        return root->value;
+    }
+}
+
+template <typename K, typename V>
+V PairingHeap<K,V>::extractMin() {
+    if (root == NULL) {
+        //Empty heap
+        return (V)0;
+    }
+
+    V minValue = root->value;
+    Node* newRoot = mergePairs(root->child);
+
+    delete root;
+    root = newRoot;
+    nodeCount--;
+
+    return minValue;
+}
+
+template <typename K, typename V>
+void PairingHeap<K,V>::detach(Node* node) {
+    //The first child is referenced by its parent
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+
+    node->prev = node->next = NULL;
+}
+
+template <typename K, typename V>
+typename PairingHeap<K,V>::Node* PairingHeap<K,V>::find(V value) const {
+    if (root == NULL) {
+        return NULL;
+    }
+
+    vector<Node*> stack(1, root);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+
+        if (curNode->value == value) {
+            return curNode;
+        }
+
+        if (curNode->child != NULL) {
+            stack.push_back(curNode->child);
+        }
+
+        if (curNode->next != NULL) {
+            stack.push_back(curNode->next);
+        }
+    }
+
+    return NULL;
+}
+
+template <typename K, typename V>
+bool PairingHeap<K,V>::decreaseKey(V value, K newKey) {
+    Node* node = find(value);
+
+    //Check that the node exists and the new key is smaller
+    if (node && newKey < node->key) {
+        node->key = newKey;
+
+        //Cut the subtree and link it with the root
+        if (node != root) {
+            detach(node);
+            root = link(root, node);
+        }
+
+        #ifdef DEBUG
+        assert (invariant());
+        #endif
+
+        return true;
+    } else {
+        return false;
+    }
+}
+
+template <typename K, typename V>
+bool PairingHeap<K,V>::remove(V value) {
+    //Decrease the key of the target node to become the new root
+    if (!isEmpty() && decreaseKey(value, root->key - (K)1)) {
+        extractMin();
+        return true;
+    }
+
+    return false;
+}
+
+#ifdef DEBUG
+template <typename K, typename V>
+bool PairingHeap<K,V>::invariant() {
+    if (isEmpty()) {
+        return nodeCount == 0;
+    }
+
+    bool invRoot = root->prev == NULL && root->next == NULL;
+    bool invNodes = true;
+    size_t count = 0;
+    vector<Node*> stack(1, root);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+        count++;
+
+        for (Node* c = curNode->child; c != NULL; c = c->next) {
+            //Heap order and chaining of the child list
+            invNodes &= !(c->key < curNode->key);
+            invNodes &= (c == curNode->child) ? c->prev == curNode : c->prev->next == c;
+            stack.push_back(c);
+        }
+    }
+
+    return invRoot && invNodes && count == nodeCount;
+}
+#endif
+
+template class PairingHeap<int,char>;
+template class PairingHeap<int,int>;
+template class PairingHeap<long long,unsigned int>;
@@ -0,0 +1,64 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdlib>
+#include <vector>
+
+#ifdef DEBUG
+#include <assert.h>
+#endif
+
+using namespace std;
+
+#ifndef PAIRINGHEAP_H
+#define PAIRINGHEAP_H
+
+template <typename K, typename V>
+class PairingHeap final {
+    private:
+        //The prev pointer of the first child points to the parent
+        struct Node {
+            Node *child, *next, *prev;
+            K key;
+            V value;
+        } *root;
+
+        size_t nodeCount;
+
+        //Reused buffer for the pairing passes of extractMin
+        vector<Node*> pairs;
+
+        inline void makeHeap();
+        void insertTree(Node* node);
+        void freeTree(Node* node);
+
+        Node* link(Node* a, Node* b);
+        Node* mergePairs(Node* first);
+        void detach(Node* node);
+        Node* find(V value) const;
+
+    public:
+        PairingHeap();
+        PairingHeap(const PairingHeap<K,V>& orig);
+        PairingHeap<K,V>& operator=(const PairingHeap<K,V>& rhs);
+        ~PairingHeap();
+
+        bool isEmpty() const;
+        void insert(K key, V value);
+        void meld(PairingHeap<K,V>* other);
+
+        V getMin() const;
+        V extractMin();
+
+        bool decreaseKey(V value, K newKey);
+        bool remove(V value);
+
+        #ifdef DEBUG
+        bool invariant();
+        #endif
+
+};
+
+#endif /* PAIRINGHEAP_H */
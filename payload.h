@@ -0,0 +1,42 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include "fibheap.h"
+
+using namespace std;
+
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+//Value type of a fixed size for the tests and benchmarks of large values.
+//Payloads are compared by their id, the remaining bytes are filler. Cold
+//selects the separate value storage of the FibonacciHeap.
+template <size_t N, bool Cold>
+struct Payload {
+    uint32_t id;
+    char data[N - sizeof(uint32_t)];
+
+    Payload(int id = 0) : id((uint32_t)id) {
+        memset(data, (int)(id & 0xff), sizeof(data));
+    }
+
+    bool operator==(const Payload<N,Cold>& other) const { return id == other.id; }
+    bool operator<(const Payload<N,Cold>& other) const { return id < other.id; }
+};
+
+template <size_t N, bool Cold>
+ostream& operator<<(ostream& out, const Payload<N,Cold>& payload) {
+    return out << payload.id;
+}
+
+template <size_t N, bool Cold>
+struct FibonacciValueLayout<Payload<N,Cold>> {
+    static const bool cold = Cold;
+};
+
+#endif /* PAYLOAD_H */
@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "radixheap.h"
+
+template <typename K, typename V>
+constexpr unsigned int RadixHeap<K,V>::bucketCount;
+
+template <typename K, typename V>
+void RadixHeap<K,V>::makeHeap() {
+    for (unsigned int i = 0; i < bucketCount; i++) {
+        buckets[i].clear();
+    }
+
+    last = numeric_limits<K>::lowest();
+    nodeCount = 0;
+}
+
+template <typename K, typename V>
+RadixHeap<K,V>::RadixHeap() {
+    makeHeap();
+}
+
+template <typename K, typename V>
+typename RadixHeap<K,V>::Bits RadixHeap<K,V>::toBits(K key) {
+    //Flip the sign bit to keep the order of signed keys
+    return numeric_limits<K>::is_signed
+        ? (Bits)key ^ ((Bits)1 << (numeric_limits<Bits>::digits - 1))
+        : (Bits)key;
+}
+
+template <typename K, typename V>
+unsigned int RadixHeap<K,V>::bucketIndex(K key) const {
+    Bits diff = toBits(key) ^ toBits(last);
+    unsigned int index = 0;
+
+    //Position of the highest differing bit
+    while (diff != 0) {
+        diff >>= 1;
+        index++;
+    }
+
+    return index;
+}
+
+template <typename K, typename V>
+bool RadixHeap<K,V>::isEmpty() const {
+    return nodeCount == 0;
+}
+
+template <typename K, typename V>
+void RadixHeap<K,V>::insert(K key, V value) {
+    #ifdef DEBUG
+    //Keys below the last extracted key would break the bucket order
+    assert (!(key < last));
+    #endif
+
+    buckets[bucketIndex(key)].push_back(make_pair(key, value));
+    nodeCount++;
+}
+
+template <typename K, typename V>
+V RadixHeap<K,V>::getMin() const {
+    for (unsigned int i = 0; i < bucketCount; i++) {
+        if (!buckets[i].empty()) {
+            const pair<K,V>* min = &buckets[i].front();
+
+            for (const pair<K,V>& item : buckets[i]) {
+                if (item.first < min->first) {
+                    min = &item;
+                }
+            }
+
+            return min->second;
+        }
+    }
+
+    //Empty heap
+    return (V)0;
+}
+
+template <typename K, typename V>
+void RadixHeap<K,V>::redistribute() {
+    unsigned int i = 1;
+
+    //Find the first non-empty bucket
+    while (buckets[i].empty()) {
+        i++;
+    }
+
+    //The smallest key of the bucket becomes the new last key
+    K min = buckets[i].front().first;
+
+    for (const pair<K,V>& item : buckets[i]) {
+        if (item.first < min) {
+            min = item.first;
+        }
+    }
+
+    last = min;
+
+    //All items move to a lower bucket
+    for (const pair<K,V>& item : buckets[i]) {
+        buckets[bucketIndex(item.first)].push_back(item);
+    }
+
+    buckets[i].clear();
+}
+
+template <typename K, typename V>
+V RadixHeap<K,V>::extractMin() {
+    if (isEmpty()) {
+        //Empty heap
+        return (V)0;
+    }
+
+    if (buckets[0].empty()) {
+        redistribute();
+    }
+
+    V minValue = buckets[0].back().second;
+    buckets[0].pop_back();
+    nodeCount--;
+
+    return minValue;
+}
+
+template <typename K, typename V>
+bool RadixHeap<K,V>::find(V value, unsigned int& bucket, size_t& index) const {
+    for (unsigned int i = 0; i < bucketCount; i++) {
+        for (size_t j = 0; j < buckets[i].size(); j++) {
+            if (buckets[i][j].second == value) {
+                bucket = i;
+                index = j;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+template <typename K, typename V>
+bool RadixHeap<K,V>::decreaseKey(V value, K newKey) {
+    unsigned int bucket;
+    size_t index;
+
+    if (!find(value, bucket, index) || !(newKey < buckets[bucket][index].first)) {
+        return false;
+    }
+
+    #ifdef DEBUG
+    assert (!(newKey < last));
+    #endif
+
+    //Move the item to the bucket of the new key
+    buckets[bucket][index] = buckets[bucket].back();
+    buckets[bucket].pop_back();
+    buckets[bucketIndex(newKey)].push_back(make_pair(newKey, value));
+
+    return true;
+}
+
+template <typename K, typename V>
+bool RadixHeap<K,V>::remove(V value) {
+    unsigned int bucket;
+    size_t index;
+
+    if (!find(value, bucket, index)) {
+        return false;
+    }
+
+    buckets[bucket][index] = buckets[bucket].back();
+    buckets[bucket].pop_back();
+    nodeCount--;
+
+    return true;
+}
+
+template class RadixHeap<int,char>;
+template class RadixHeap<int,int>;
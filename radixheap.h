@@ -0,0 +1,54 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <vector>
+#include <utility>
+#include <limits>
+#include <type_traits>
+
+#ifdef DEBUG
+#include <assert.h>
+#endif
+
+using namespace std;
+
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+//Priority queue for integer keys where the extracted keys never decrease.
+//Inserted keys must not be smaller than the last extracted key.
+template <typename K, typename V>
+class RadixHeap final {
+    private:
+        typedef typename make_unsigned<K>::type Bits;
+        static constexpr unsigned int bucketCount = numeric_limits<Bits>::digits + 1;
+
+        //Bucket i holds the keys that differ from the last key in the bit i-1
+        //and all higher bits are equal. Bucket 0 holds keys equal to the last key.
+        vector<pair<K,V>> buckets[bucketCount];
+        K last;
+
+        size_t nodeCount;
+
+        inline void makeHeap();
+        static inline Bits toBits(K key);
+        inline unsigned int bucketIndex(K key) const;
+        void redistribute();
+        bool find(V value, unsigned int& bucket, size_t& index) const;
+
+    public:
+        RadixHeap();
+
+        bool isEmpty() const;
+        void insert(K key, V value);
+
+        V getMin() const;
+        V extractMin();
+
+        bool decreaseKey(V value, K newKey);
+        bool remove(V value);
+};
+
+#endif /* RADIXHEAP_H */
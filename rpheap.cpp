@@ -0,0 +1,443 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "rpheap.h"
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::makeHeap() {
+    min = NULL;
+    nodeCount = 0;
+}
+
+template <typename K, typename V>
+RankPairingHeap<K,V>::RankPairingHeap() {
+    makeHeap();
+}
+
+template <typename K, typename V>
+RankPairingHeap<K,V>::RankPairingHeap(const RankPairingHeap<K,V>& orig) {
+    makeHeap();
+
+    if (!orig.isEmpty()) {
+        insertTrees(orig.min);
+    }
+}
+
+template <typename K, typename V>
+RankPairingHeap<K,V>& RankPairingHeap<K,V>::operator=(const RankPairingHeap<K,V>& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    //Free the current nodes
+    if (!isEmpty()) {
+        freeTrees(min);
+        makeHeap();
+    }
+
+    if (!rhs.isEmpty()) {
+        insertTrees(rhs.min);
+    }
+
+    return *this;
+}
+
+template <typename K, typename V>
+RankPairingHeap<K,V>::~RankPairingHeap() {
+    if (!isEmpty()) {
+        freeTrees(min);
+    }
+}
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::insertTrees(Node* node) {
+    vector<Node*> stack;
+    Node* curRoot = node;
+
+    do {
+        stack.push_back(curRoot);
+        curRoot = curRoot->right;
+    } while (curRoot != node);
+
+    //Inside the half-trees both children are regular subtrees
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+
+        insert(curNode->key, curNode->value);
+
+        if (curNode->left != NULL) {
+            stack.push_back(curNode->left);
+        }
+
+        if (curNode->parent != NULL && curNode->right != NULL) {
+            stack.push_back(curNode->right);
+        }
+    }
+}
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::freeTrees(Node* node) {
+    vector<Node*> stack;
+    Node* curRoot = node;
+
+    do {
+        stack.push_back(curRoot);
+        curRoot = curRoot->right;
+    } while (curRoot != node);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+
+        if (curNode->left != NULL) {
+            stack.push_back(curNode->left);
+        }
+
+        if (curNode->parent != NULL && curNode->right != NULL) {
+            stack.push_back(curNode->right);
+        }
+
+        delete curNode;
+    }
+}
+
+template <typename K, typename V>
+int RankPairingHeap<K,V>::rank(Node* node) const {
+    //Missing children have the rank -1
+    return (node == NULL) ? -1 : node->rank;
+}
+
+template <typename K, typename V>
+bool RankPairingHeap<K,V>::isEmpty() const {
+    return min == NULL;
+}
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::appendRoot(Node* node) {
+    node->parent = NULL;
+
+    if (min == NULL) {
+        node->right = node;
+        min = node;
+
+    } else {
+        //Insert the node after the min node
+        node->right = min->right;
+        min->right = node;
+
+        if (node->key < min->key) {
+            min = node;
+        }
+    }
+}
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::insert(K key, V value) {
+    Node* node = new Node;
+
+    //Initialize the node values
+    node->left = NULL;
+    node->key = key;
+    node->value = value;
+    node->rank = 0;
+
+    appendRoot(node);
+    nodeCount++;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+}
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::meld(RankPairingHeap<K,V>* other) {
+    if (other == NULL || other == this || other->isEmpty()) {
+        return;
+    }
+
+    if (min == NULL) {
+        min = other->min;
+
+    } else {
+        //Concatenate the circular rootlists behind both min nodes
+        Node* next = min->right;
+        min->right = other->min->right;
+        other->min->right = next;
+
+        if (other->min->key < min->key) {
+            min = other->min;
+        }
+    }
+
+    nodeCount += other->nodeCount;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    //Reset the second heap to prevent unexpected side-effects
+    other->makeHeap();
+}
+
+template <typename K, typename V>
+typename RankPairingHeap<K,V>::Node* RankPairingHeap<K,V>::link(Node* a, Node* b) {
+    //Make sure that a is the smaller node
+    if (b->key < a->key) {
+        Node* swap = a;
+        a = b;
+        b = swap;
+    }
+
+    //b becomes the left child of a and keeps the old left subtree of a on its right
+    b->right = a->left;
+    b->parent = a;
+
+    if (a->left != NULL) {
+        a->left->parent = b;
+    }
+
+    a->left = b;
+    a->rank++;
+    return a;
+}
+
+template <typename K, typename V>
+V RankPairingHeap<K,V>::getMin() const {
+    if (min == NULL) {
+        //Empty heap
+        return (V)0;
+    } else {
+        return min->value;
+    }
+}
+
+template <typename K, typename V>
+V RankPairingHeap<K,V>::extractMin() {
+    if (min == NULL) {
+        //Empty heap
+        return (V)0;
+    }
+
+    V minValue = min->value;
+    roots.clear();
+
+    //The right spine of the left child becomes a list of new half-trees
+    Node* curNode = min->left;
+
+    while (curNode != NULL) {
+        Node* next = curNode->right;
+        curNode->right = NULL;
+        curNode->parent = NULL;
+        curNode->rank = rank(curNode->left) + 1;
+
+        roots.push_back(curNode);
+        curNode = next;
+    }
+
+    //Collect the remaining roots
+    for (curNode = min->right; curNode != min; curNode = curNode->right) {
+        roots.push_back(curNode);
+    }
+
+    delete min;
+    min = NULL;
+    nodeCount--;
+
+    //One pass linking: each pair of equal ranks is linked once
+    for (Node* node : roots) {
+        if ((size_t)node->rank >= buckets.size()) {
+            buckets.resize(node->rank + 1, NULL);
+        }
+
+        Node*& bucket = buckets[node->rank];
+
+        if (bucket == NULL) {
+            bucket = node;
+        } else {
+            Node* linked = link(bucket, node);
+            bucket = NULL;
+            appendRoot(linked);
+        }
+    }
+
+    //Unlinked half-trees go back to the rootlist
+    for (Node*& bucket : buckets) {
+        if (bucket != NULL) {
+            appendRoot(bucket);
+            bucket = NULL;
+        }
+    }
+
+    return minValue;
+}
+
+template <typename K, typename V>
+void RankPairingHeap<K,V>::repairRanks(Node* node) {
+    //Walk up until a rank does not decrease
+    while (node != NULL) {
+        int newRank;
+
+        if (node->parent == NULL) {
+            newRank = rank(node->left) + 1;
+        } else {
+            int r1 = rank(node->left);
+            int r2 = rank(node->right);
+
+            //Type-2 rank rule
+            newRank = (r1 - r2 > 1 || r2 - r1 > 1)
+                ? max(r1, r2)
+                : max(r1, r2) + 1;
+        }
+
+        if (newRank >= node->rank) {
+            break;
+        }
+
+        node->rank = newRank;
+        node = node->parent;
+    }
+}
+
+template <typename K, typename V>
+typename RankPairingHeap<K,V>::Node* RankPairingHeap<K,V>::find(V value) const {
+    if (min == NULL) {
+        return NULL;
+    }
+
+    vector<Node*> stack;
+    Node* curRoot = min;
+
+    do {
+        stack.push_back(curRoot);
+        curRoot = curRoot->right;
+    } while (curRoot != min);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back();
+        stack.pop_back();
+
+        if (curNode->value == value) {
+            return curNode;
+        }
+
+        if (curNode->left != NULL) {
+            stack.push_back(curNode->left);
+        }
+
+        if (curNode->parent != NULL && curNode->right != NULL) {
+            stack.push_back(curNode->right);
+        }
+    }
+
+    return NULL;
+}
+
+template <typename K, typename V>
+bool RankPairingHeap<K,V>::decreaseKey(V value, K newKey) {
+    Node* node = find(value);
+
+    //Check that the node exists and the new key is smaller
+    if (!node || !(newKey < node->key)) {
+        return false;
+    }
+
+    node->key = newKey;
+
+    if (node->parent == NULL) {
+        //Roots only need the min pointer update
+        if (newKey < min->key) {
+            min = node;
+        }
+
+    } else {
+        //The right subtree takes the place of the node
+        Node* parent = node->parent;
+        Node* right = node->right;
+
+        if (parent->left == node) {
+            parent->left = right;
+        } else {
+            parent->right = right;
+        }
+
+        if (right != NULL) {
+            right->parent = parent;
+        }
+
+        //The node becomes a new half-tree with its left subtree
+        node->rank = rank(node->left) + 1;
+        appendRoot(node);
+
+        repairRanks(parent);
+    }
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    return true;
+}
+
+template <typename K, typename V>
+bool RankPairingHeap<K,V>::remove(V value) {
+    //Decrease the key of the target node to become the new min node
+    if (!isEmpty() && decreaseKey(value, min->key - (K)1)) {
+        extractMin();
+        return true;
+    }
+
+    return false;
+}
+
+#ifdef DEBUG
+template <typename K, typename V>
+bool RankPairingHeap<K,V>::invariant() {
+    if (isEmpty()) {
+        return nodeCount == 0;
+    }
+
+    bool invNodes = true;
+    size_t count = 0;
+
+    //Every node is stored with the node whose left subtree contains it
+    vector<pair<Node*,Node*>> stack;
+    Node* curRoot = min;
+
+    do {
+        //Roots are half-trees and the min node has the lowest key
+        invNodes &= curRoot->parent == NULL && !(curRoot->key < min->key);
+        invNodes &= curRoot->rank == rank(curRoot->left) + 1;
+        stack.push_back(make_pair(curRoot, (Node*)NULL));
+        curRoot = curRoot->right;
+    } while (curRoot != min);
+
+    while (!stack.empty()) {
+        Node* curNode = stack.back().first;
+        Node* owner = stack.back().second;
+        stack.pop_back();
+        count++;
+
+        //Heap order within the half-tree
+        invNodes &= owner == NULL || !(curNode->key < owner->key);
+
+        if (curNode->left != NULL) {
+            invNodes &= curNode->left->parent == curNode;
+            stack.push_back(make_pair(curNode->left, curNode));
+        }
+
+        if (curNode->parent != NULL && curNode->right != NULL) {
+            invNodes &= curNode->right->parent == curNode;
+            stack.push_back(make_pair(curNode->right, owner));
+        }
+    }
+
+    return invNodes && count == nodeCount;
+}
+#endif
+
+template class RankPairingHeap<int,char>;
+template class RankPairingHeap<int,int>;
+template class RankPairingHeap<long long,unsigned int>;
@@ -0,0 +1,71 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdlib>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#ifdef DEBUG
+#include <assert.h>
+#endif
+
+using namespace std;
+
+#ifndef RPHEAP_H
+#define RPHEAP_H
+
+//Rank-pairing heap with type-2 rank rule
+template <typename K, typename V>
+class RankPairingHeap final {
+    private:
+        //Every root is a half-tree without a right child.
+        //The right pointer of the roots links the circular rootlist.
+        struct Node {
+            Node *left, *right, *parent;
+            K key;
+            V value;
+            int rank;
+        } *min;
+
+        size_t nodeCount;
+
+        //Reused buffers for the linking pass of extractMin
+        vector<Node*> roots;
+        vector<Node*> buckets;
+
+        inline void makeHeap();
+        void insertTrees(Node* node);
+        void freeTrees(Node* node);
+
+        inline int rank(Node* node) const;
+        inline void appendRoot(Node* node);
+        Node* link(Node* a, Node* b);
+        void repairRanks(Node* node);
+        Node* find(V value) const;
+
+    public:
+        RankPairingHeap();
+        RankPairingHeap(const RankPairingHeap<K,V>& orig);
+        RankPairingHeap<K,V>& operator=(const RankPairingHeap<K,V>& rhs);
+        ~RankPairingHeap();
+
+        bool isEmpty() const;
+        void insert(K key, V value);
+        void meld(RankPairingHeap<K,V>* other);
+
+        V getMin() const;
+        V extractMin();
+
+        bool decreaseKey(V value, K newKey);
+        bool remove(V value);
+
+        #ifdef DEBUG
+        bool invariant();
+        #endif
+
+};
+
+#endif /* RPHEAP_H */
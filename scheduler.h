@@ -0,0 +1,377 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <exception>
+#include "fibheap.h"
+
+#ifdef __cpp_impl_coroutine
+#include <coroutine>
+#endif
+
+using namespace std;
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+//The coroutines need C++20, with older standards the header is empty. The
+//scheduler is defined in the header since the library objects are compiled
+//with C++14.
+#ifdef __cpp_impl_coroutine
+
+class Scheduler;
+
+//Coroutine type of the tasks. A task starts suspended and the scheduler owns
+//its frame after the spawn, otherwise the frame is destroyed with the task.
+class Task final {
+    public:
+        struct promise_type {
+            Scheduler* scheduler;
+            int priority;
+
+            //Position in the ready heap, the ticket orders equal priorities
+            FibonacciHeap<long long,void*>::Handle handle;
+            uint64_t ticket;
+            bool ready;
+
+            uint32_t slot;
+            exception_ptr error;
+
+            promise_type() : scheduler(NULL), priority(0), ticket(0), ready(false), slot(0) {}
+
+            Task get_return_object() { return Task(coroutine_handle<promise_type>::from_promise(*this)); }
+            suspend_always initial_suspend() noexcept { return suspend_always(); }
+            suspend_always final_suspend() noexcept { return suspend_always(); }
+            void return_void() {}
+            void unhandled_exception() { error = current_exception(); }
+        };
+
+        Task(Task&& orig) : coroutine(orig.coroutine) { orig.coroutine = coroutine_handle<promise_type>(); }
+        ~Task();
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+    private:
+        friend class Scheduler;
+        coroutine_handle<promise_type> coroutine;
+
+        explicit Task(coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+};
+
+//Awaitable that suspends the task until the deadline
+struct SleepAwaiter {
+    long long deadline;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(coroutine_handle<Task::promise_type> coroutine);
+    void await_resume() const noexcept {}
+};
+
+//Awaitable that lets the tasks with a lower or equal priority run first
+struct YieldAwaiter {
+    int priority;
+    bool keep;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(coroutine_handle<Task::promise_type> coroutine);
+    void await_resume() const noexcept {}
+};
+
+inline SleepAwaiter sleepUntil(long long deadline) {
+    return SleepAwaiter{deadline};
+}
+
+//Keep the priority or continue with a new one
+inline YieldAwaiter yield() {
+    return YieldAwaiter{0, true};
+}
+
+inline YieldAwaiter yield(int priority) {
+    return YieldAwaiter{priority, false};
+}
+
+//Single threaded scheduler for coroutine tasks. Ready tasks are resumed by
+//their priority, lower values first and equal priorities in FIFO order.
+//Sleeping tasks wait in a second heap by their deadline. The time is counted
+//in nanoseconds of the steady clock. With virtual time the clock jumps to the
+//next deadline when no task is ready, otherwise the thread sleeps.
+class Scheduler final {
+    public:
+        //Priorities are clamped to the range from 0 to maxPriority
+        static const int maxPriority = (1 << 22) - 1;
+
+        //Reference to a spawned task for the reprioritization
+        class TaskId {
+            private:
+                friend class Scheduler;
+                uint32_t slot;
+                uint32_t generation;
+
+                TaskId(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+
+            public:
+                TaskId() : slot(UINT32_MAX), generation(0) {}
+        };
+
+        Scheduler(bool virtualTime = false);
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        TaskId spawn(Task task, int priority = 0);
+
+        //A lower priority of a ready task decreases its key in place
+        bool setPriority(TaskId id, int priority);
+
+        long long now() const;
+        size_t taskCount() const;
+        size_t switchCount() const;
+
+        //Resume tasks until all are finished. An exception of a task is
+        //rethrown after its frame is destroyed.
+        void run();
+
+    private:
+        friend struct SleepAwaiter;
+        friend struct YieldAwaiter;
+
+        typedef FibonacciHeap<long long,void*> Heap;
+        typedef Task::promise_type Promise;
+
+        //Tickets use the lower bits of the ready keys
+        static const int ticketBits = 40;
+
+        struct Slot {
+            Promise* promise;
+            uint32_t generation;
+            uint32_t nextFree;
+        };
+
+        Heap ready;
+        Heap sleeping;
+
+        vector<Slot> slots;
+        uint32_t freeSlot;
+
+        uint64_t nextTicket;
+        vector<pair<long long,void*>> expired;
+
+        bool virtualTime;
+        long long clock;
+        size_t tasks;
+        size_t switches;
+
+        static int clampPriority(int priority);
+        static long long readyKey(int priority, uint64_t ticket);
+
+        void makeReady(Promise& promise);
+        void suspendUntil(Promise& promise, long long deadline);
+        void wake();
+        void renumber();
+};
+
+inline Task::~Task() {
+    if (coroutine) {
+        coroutine.destroy();
+    }
+}
+
+inline void SleepAwaiter::await_suspend(coroutine_handle<Task::promise_type> coroutine) {
+    coroutine.promise().scheduler->suspendUntil(coroutine.promise(), deadline);
+}
+
+inline void YieldAwaiter::await_suspend(coroutine_handle<Task::promise_type> coroutine) {
+    Task::promise_type& promise = coroutine.promise();
+
+    if (!keep) {
+        promise.priority = Scheduler::clampPriority(priority);
+    }
+
+    promise.scheduler->makeReady(promise);
+}
+
+inline Scheduler::Scheduler(bool virtualTime) {
+    this->virtualTime = virtualTime;
+    freeSlot = UINT32_MAX;
+    nextTicket = 0;
+    clock = 0;
+    tasks = 0;
+    switches = 0;
+}
+
+inline Scheduler::~Scheduler() {
+    //The heaps only hold addresses, the frames of unfinished tasks are destroyed here
+    for (const Slot& slot : slots) {
+        if (slot.promise != NULL) {
+            coroutine_handle<Promise>::from_promise(*slot.promise).destroy();
+        }
+    }
+}
+
+inline int Scheduler::clampPriority(int priority) {
+    return min(max(priority, 0), maxPriority);
+}
+
+inline long long Scheduler::readyKey(int priority, uint64_t ticket) {
+    return ((long long)priority << ticketBits) | (long long)ticket;
+}
+
+inline Scheduler::TaskId Scheduler::spawn(Task task, int priority) {
+    Promise& promise = task.coroutine.promise();
+    task.coroutine = coroutine_handle<Promise>();
+
+    uint32_t slot;
+
+    if (freeSlot != UINT32_MAX) {
+        slot = freeSlot;
+        freeSlot = slots[slot].nextFree;
+    } else {
+        slots.push_back(Slot{NULL, 0, UINT32_MAX});
+        slot = (uint32_t)(slots.size() - 1);
+    }
+
+    slots[slot].promise = &promise;
+    promise.scheduler = this;
+    promise.priority = clampPriority(priority);
+    promise.slot = slot;
+    tasks++;
+
+    makeReady(promise);
+    return TaskId(slot, slots[slot].generation);
+}
+
+inline bool Scheduler::setPriority(TaskId id, int priority) {
+    if (id.slot >= slots.size() || slots[id.slot].generation != id.generation) {
+        return false;
+    }
+
+    Promise& promise = *slots[id.slot].promise;
+    promise.priority = clampPriority(priority);
+
+    //Sleeping and running tasks use the priority when they become ready,
+    //a ready task keeps its ticket and with it the order in the new priority
+    if (promise.ready) {
+        ready.updateKey(promise.handle, readyKey(promise.priority, promise.ticket));
+    }
+
+    return true;
+}
+
+inline long long Scheduler::now() const {
+    if (virtualTime) {
+        return clock;
+    }
+
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline size_t Scheduler::taskCount() const {
+    return tasks;
+}
+
+inline size_t Scheduler::switchCount() const {
+    return switches;
+}
+
+inline void Scheduler::makeReady(Promise& promise) {
+    if (nextTicket == ((uint64_t)1 << ticketBits)) {
+        renumber();
+    }
+
+    promise.ticket = nextTicket++;
+    promise.ready = true;
+    promise.handle = ready.insert(readyKey(promise.priority, promise.ticket),
+                                  coroutine_handle<Promise>::from_promise(promise).address());
+}
+
+inline void Scheduler::suspendUntil(Promise& promise, long long deadline) {
+    sleeping.insert(deadline, coroutine_handle<Promise>::from_promise(promise).address());
+}
+
+inline void Scheduler::wake() {
+    if (sleeping.isEmpty()) {
+        return;
+    }
+
+    //All expired tasks are extracted with a single consolidation in the
+    //order of their deadlines
+    expired.clear();
+    sleeping.extractUpTo(now(), expired);
+
+    for (const pair<long long,void*>& task : expired) {
+        makeReady(coroutine_handle<Promise>::from_address(task.second).promise());
+    }
+}
+
+inline void Scheduler::renumber() {
+    //The tickets are reassigned in the current order before they overflow
+    vector<void*> order;
+
+    while (!ready.isEmpty()) {
+        order.push_back(ready.extractMin());
+    }
+
+    nextTicket = 0;
+
+    for (void* address : order) {
+        makeReady(coroutine_handle<Promise>::from_address(address).promise());
+    }
+}
+
+inline void Scheduler::run() {
+    while (tasks > 0) {
+        wake();
+
+        if (ready.isEmpty()) {
+            //The remaining tasks wait for something else than the scheduler
+            if (sleeping.isEmpty()) {
+                break;
+            }
+
+            long long deadline = sleeping.getMinKey();
+
+            if (virtualTime) {
+                clock = deadline;
+            } else {
+                this_thread::sleep_for(chrono::nanoseconds(deadline - now()));
+            }
+
+            continue;
+        }
+
+        coroutine_handle<Promise> coroutine = coroutine_handle<Promise>::from_address(ready.extractMin());
+        Promise& promise = coroutine.promise();
+        promise.ready = false;
+        switches++;
+        coroutine.resume();
+
+        if (coroutine.done()) {
+            exception_ptr error = promise.error;
+            Slot& slot = slots[promise.slot];
+
+            slot.promise = NULL;
+            slot.generation++;
+            slot.nextFree = freeSlot;
+            freeSlot = promise.slot;
+
+            coroutine.destroy();
+            tasks--;
+
+            if (error) {
+                rethrow_exception(error);
+            }
+        }
+    }
+}
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* SCHEDULER_H */
@@ -0,0 +1,82 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "simdmin.h"
+
+#if !defined(FIBHEAP_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMDMIN_X86
+#include <immintrin.h>
+#endif
+
+#ifdef SIMDMIN_X86
+__attribute__((target("avx2")))
+static int minKeyAvx2(const int* keys, size_t count) {
+    __m256i min = _mm256_load_si256((const __m256i*)keys);
+
+    for (size_t i = 8; i < count; i += 8) {
+        min = _mm256_min_epi32(min, _mm256_load_si256((const __m256i*)(keys + i)));
+    }
+
+    //Reduce the eight lanes to a single key
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(min), _mm256_extracti128_si256(min, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+
+__attribute__((target("sse4.1")))
+static int minKeySse41(const int* keys, size_t count) {
+    __m128i min = _mm_load_si128((const __m128i*)keys);
+
+    for (size_t i = 4; i < count; i += 4) {
+        min = _mm_min_epi32(min, _mm_load_si128((const __m128i*)(keys + i)));
+    }
+
+    //Reduce the four lanes to a single key
+    min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+    min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(min);
+}
+#endif
+
+typedef int (*MinKeyFunc)(const int*, size_t);
+
+//Select the widest instruction set supported by the running CPU
+static MinKeyFunc selectMinKey(const char** name) {
+    #ifdef SIMDMIN_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "avx2";
+        return minKeyAvx2;
+    }
+
+    if (__builtin_cpu_supports("sse4.1")) {
+        *name = "sse4.1";
+        return minKeySse41;
+    }
+    #endif
+
+    *name = "scalar";
+    return minKeyScalar<int>;
+}
+
+static const char* minKeyName = "scalar";
+
+//The dispatch runs on first use to be safe during static initialization
+static MinKeyFunc minKeyDispatch() {
+    static const MinKeyFunc func = selectMinKey(&minKeyName);
+    return func;
+}
+
+template <>
+int minKey<int>(const int* keys, size_t count) {
+    return minKeyDispatch()(keys, count);
+}
+
+const char* minKeyInstructionSet() {
+    minKeyDispatch();
+    return minKeyName;
+}
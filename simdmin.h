@@ -0,0 +1,44 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstddef>
+
+using namespace std;
+
+#ifndef SIMDMIN_H
+#define SIMDMIN_H
+
+//Alignment and length granularity of the key arrays
+#define SIMDMIN_ALIGN 32
+#define SIMDMIN_LANES 8
+
+//Smallest key of an array. The array must be aligned to SIMDMIN_ALIGN
+//bytes and the count must be a multiple of SIMDMIN_LANES.
+template <typename K>
+K minKeyScalar(const K* keys, size_t count) {
+    K min = keys[0];
+
+    for (size_t i = 1; i < count; i++) {
+        if (keys[i] < min) {
+            min = keys[i];
+        }
+    }
+
+    return min;
+}
+
+template <typename K>
+inline K minKey(const K* keys, size_t count) {
+    return minKeyScalar(keys, count);
+}
+
+//Vectorized search for integer keys with runtime CPU dispatch
+template <>
+int minKey<int>(const int* keys, size_t count);
+
+//Name of the instruction set selected for minKey<int>
+const char* minKeyInstructionSet();
+
+#endif /* SIMDMIN_H */
@@ -0,0 +1,513 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "softheap.h"
+
+template <typename K, typename V>
+void SoftHeap<K,V>::makeHeap() {
+    first = NULL;
+    maxRank = -1;
+    nodeCount = 0;
+    extractCount = 0;
+    corruptExtractCount = 0;
+}
+
+template <typename K, typename V>
+SoftHeap<K,V>::SoftHeap(double epsilon) {
+    //Nodes up to this rank hold a single item and are never corrupted
+    this->epsilon = (epsilon > 0 && epsilon < 1) ? epsilon : 0.5;
+    rankThreshold = 2 + 2 * (int)ceil(log2(1 / this->epsilon));
+    makeHeap();
+}
+
+template <typename K, typename V>
+SoftHeap<K,V>::SoftHeap(const SoftHeap<K,V>& orig) {
+    epsilon = orig.epsilon;
+    rankThreshold = orig.rankThreshold;
+    makeHeap();
+    copyHeap(orig);
+}
+
+template <typename K, typename V>
+SoftHeap<K,V>& SoftHeap<K,V>::operator=(const SoftHeap<K,V>& rhs) {
+    if (this != &rhs) {
+        freeHeap();
+
+        epsilon = rhs.epsilon;
+        rankThreshold = rhs.rankThreshold;
+        makeHeap();
+        copyHeap(rhs);
+    }
+
+    return *this;
+}
+
+template <typename K, typename V>
+SoftHeap<K,V>::~SoftHeap() {
+    freeHeap();
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::copyHeap(const SoftHeap<K,V>& orig) {
+    //The structure is copied to keep the same corruption
+    Tree* last = NULL;
+
+    for (Tree* tree = orig.first; tree != NULL; tree = tree->next) {
+        Tree* copy = new Tree;
+        copy->root = copyNode(tree->root);
+        copy->rank = tree->rank;
+        copy->prev = last;
+        copy->next = NULL;
+
+        if (last == NULL) {
+            first = copy;
+        } else {
+            last->next = copy;
+        }
+
+        last = copy;
+    }
+
+    maxRank = orig.maxRank;
+    nodeCount = orig.nodeCount;
+    extractCount = orig.extractCount;
+    corruptExtractCount = orig.corruptExtractCount;
+
+    if (last != NULL) {
+        updateSuffixMin(last);
+    }
+}
+
+template <typename K, typename V>
+typename SoftHeap<K,V>::Node* SoftHeap<K,V>::copyNode(Node* node) {
+    if (node == NULL) {
+        return NULL;
+    }
+
+    Node* copy = new Node(*node);
+    copy->head = copy->tail = NULL;
+
+    for (Item* item = node->head; item != NULL; item = item->next) {
+        Item* itemCopy = new Item(*item);
+        itemCopy->next = NULL;
+
+        if (copy->tail == NULL) {
+            copy->head = itemCopy;
+        } else {
+            copy->tail->next = itemCopy;
+        }
+
+        copy->tail = itemCopy;
+    }
+
+    //The recursion depth is bounded by the rank
+    copy->left = copyNode(node->left);
+    copy->right = copyNode(node->right);
+    return copy;
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::freeHeap() {
+    Tree* tree = first;
+
+    while (tree != NULL) {
+        Tree* next = tree->next;
+        freeNode(tree->root);
+        delete tree;
+        tree = next;
+    }
+
+    first = NULL;
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::freeNode(Node* node) {
+    if (node == NULL) {
+        return;
+    }
+
+    Item* item = node->head;
+
+    while (item != NULL) {
+        Item* next = item->next;
+        delete item;
+        item = next;
+    }
+
+    freeNode(node->left);
+    freeNode(node->right);
+    delete node;
+}
+
+template <typename K, typename V>
+bool SoftHeap<K,V>::isEmpty() const {
+    return first == NULL;
+}
+
+template <typename K, typename V>
+size_t SoftHeap<K,V>::size() const {
+    return nodeCount;
+}
+
+template <typename K, typename V>
+double SoftHeap<K,V>::getEpsilon() const {
+    return epsilon;
+}
+
+template <typename K, typename V>
+bool SoftHeap<K,V>::leaf(Node* node) const {
+    return node->left == NULL && node->right == NULL;
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::insert(K key, V value) {
+    Item* item = new Item;
+    item->key = key;
+    item->value = value;
+    item->next = NULL;
+
+    Node* node = new Node;
+    node->left = node->right = NULL;
+    node->head = node->tail = item;
+    node->listSize = 1;
+    node->size = 1;
+    node->rank = 0;
+    node->ckey = key;
+
+    Tree* tree = new Tree;
+    tree->prev = tree->next = NULL;
+    tree->sufmin = tree;
+    tree->root = node;
+    tree->rank = 0;
+
+    //Insertion is a meld with a single tree
+    meldList(tree, 0);
+    nodeCount++;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::meld(SoftHeap<K,V>* other) {
+    if (other == NULL || other == this || other->isEmpty()) {
+        return;
+    }
+
+    //The rank threshold of this heap applies to all following combinations
+    meldList(other->first, other->maxRank);
+    nodeCount += other->nodeCount;
+    extractCount += other->extractCount;
+    corruptExtractCount += other->corruptExtractCount;
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    //Reset the second heap to prevent unexpected side-effects
+    other->makeHeap();
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::meldList(Tree* otherFirst, int otherRank) {
+    if (first == NULL) {
+        first = otherFirst;
+        maxRank = otherRank;
+        return;
+    }
+
+    //The trees of the list with the lower max rank are merged into the other list
+    Tree* smallFirst = otherFirst;
+    int smallRank = otherRank;
+
+    if (otherRank > maxRank) {
+        smallFirst = first;
+        smallRank = maxRank;
+        first = otherFirst;
+        maxRank = otherRank;
+    }
+
+    Tree* before = first;
+    Tree* tree = smallFirst;
+
+    while (tree != NULL) {
+        //The last tree has the max rank so the search never runs out of trees
+        while (before->rank < tree->rank) {
+            before = before->next;
+        }
+
+        Tree* next = tree->next;
+        insertTree(tree, before);
+        tree = next;
+    }
+
+    repeatedCombine(smallRank);
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::insertTree(Tree* tree, Tree* before) {
+    tree->next = before;
+    tree->prev = before->prev;
+
+    if (before->prev == NULL) {
+        first = tree;
+    } else {
+        before->prev->next = tree;
+    }
+
+    before->prev = tree;
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::removeTree(Tree* tree) {
+    if (tree->prev == NULL) {
+        first = tree->next;
+    } else {
+        tree->prev->next = tree->next;
+    }
+
+    if (tree->next != NULL) {
+        tree->next->prev = tree->prev;
+    }
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::repeatedCombine(int rank) {
+    Tree* tree = first;
+
+    //Combine trees of equal rank like the carries of a binary addition
+    while (tree->next != NULL) {
+        Tree* next = tree->next;
+
+        if (tree->rank == next->rank) {
+            //With three equal ranks the last two trees are combined
+            if (next->next == NULL || next->next->rank != tree->rank) {
+                tree->root = combine(tree->root, next->root);
+                tree->rank = tree->root->rank;
+
+                removeTree(next);
+                delete next;
+                continue;
+            }
+
+        } else if (tree->rank > rank) {
+            //No more carries from the merged trees
+            break;
+        }
+
+        tree = next;
+    }
+
+    if (tree->next == NULL) {
+        maxRank = tree->rank;
+    }
+
+    updateSuffixMin(tree);
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::updateSuffixMin(Tree* tree) {
+    for (; tree != NULL; tree = tree->prev) {
+        if (tree->next == NULL || !(tree->next->sufmin->root->ckey < tree->root->ckey)) {
+            tree->sufmin = tree;
+        } else {
+            tree->sufmin = tree->next->sufmin;
+        }
+    }
+}
+
+template <typename K, typename V>
+typename SoftHeap<K,V>::Node* SoftHeap<K,V>::combine(Node* a, Node* b) {
+    Node* node = new Node;
+    node->left = a;
+    node->right = b;
+    node->head = node->tail = NULL;
+    node->listSize = 0;
+    node->rank = a->rank + 1;
+
+    //Above the threshold the nodes grow to hold multiple items
+    node->size = (node->rank <= rankThreshold) ? 1 : (3 * a->size + 1) / 2;
+
+    sift(node);
+    return node;
+}
+
+template <typename K, typename V>
+void SoftHeap<K,V>::sift(Node* node) {
+    while (node->listSize < node->size && !leaf(node)) {
+        //Make sure that the left child has the lower ckey
+        if (node->left == NULL || (node->right != NULL && node->right->ckey < node->left->ckey)) {
+            Node* swap = node->left;
+            node->left = node->right;
+            node->right = swap;
+        }
+
+        //Move the items of the child into the node and raise the ckey
+        Node* child = node->left;
+
+        if (node->tail == NULL) {
+            node->head = child->head;
+        } else {
+            node->tail->next = child->head;
+        }
+
+        node->tail = child->tail;
+        node->listSize += child->listSize;
+        node->ckey = child->ckey;
+
+        child->head = child->tail = NULL;
+        child->listSize = 0;
+
+        if (leaf(child)) {
+            delete child;
+            node->left = NULL;
+        } else {
+            sift(child);
+        }
+    }
+}
+
+template <typename K, typename V>
+V SoftHeap<K,V>::getMin() const {
+    if (first == NULL) {
+        //Empty heap
+        return (V)0;
+    } else {
+        return first->sufmin->root->head->value;
+    }
+}
+
+template <typename K, typename V>
+V SoftHeap<K,V>::extractMin() {
+    if (first == NULL) {
+        //Empty heap
+        return (V)0;
+    }
+
+    Tree* tree = first->sufmin;
+    Node* node = tree->root;
+
+    //Remove the first item from the list of the root
+    Item* item = node->head;
+    node->head = item->next;
+    node->listSize--;
+
+    if (node->head == NULL) {
+        node->tail = NULL;
+    }
+
+    extractCount++;
+
+    if (item->key < node->ckey) {
+        corruptExtractCount++;
+    }
+
+    V minValue = item->value;
+    delete item;
+    nodeCount--;
+
+    //Refill the list when it is at most half full
+    if (2 * node->listSize <= node->size) {
+        if (!leaf(node)) {
+            sift(node);
+            updateSuffixMin(tree);
+
+        } else if (node->listSize == 0) {
+            Tree* prev = tree->prev;
+            removeTree(tree);
+
+            if (prev != NULL && prev->next == NULL) {
+                maxRank = prev->rank;
+            } else if (first == NULL) {
+                maxRank = -1;
+            }
+
+            delete node;
+            delete tree;
+            updateSuffixMin(prev);
+        }
+    }
+
+    return minValue;
+}
+
+template <typename K, typename V>
+size_t SoftHeap<K,V>::corruptedCount() const {
+    size_t corrupted = 0;
+    vector<Node*> stack;
+
+    for (Tree* tree = first; tree != NULL; tree = tree->next) {
+        stack.push_back(tree->root);
+    }
+
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+
+        //Items below the ckey of their node were raised
+        for (Item* item = node->head; item != NULL; item = item->next) {
+            if (item->key < node->ckey) {
+                corrupted++;
+            }
+        }
+
+        if (node->left != NULL) {
+            stack.push_back(node->left);
+        }
+
+        if (node->right != NULL) {
+            stack.push_back(node->right);
+        }
+    }
+
+    return corrupted;
+}
+
+template <typename K, typename V>
+double SoftHeap<K,V>::corruptionRatio() const {
+    return (nodeCount == 0) ? 0 : (double)corruptedCount() / nodeCount;
+}
+
+template <typename K, typename V>
+double SoftHeap<K,V>::extractCorruptionRatio() const {
+    return (extractCount == 0) ? 0 : (double)corruptExtractCount / extractCount;
+}
+
+#ifdef DEBUG
+template <typename K, typename V>
+bool SoftHeap<K,V>::invariant() {
+    bool invTrees = true;
+    size_t count = 0;
+    vector<Node*> stack;
+
+    for (Tree* tree = first; tree != NULL; tree = tree->next) {
+        //Ranks are increasing and the last rank is the max rank
+        invTrees &= tree->next == NULL ? tree->rank == maxRank : tree->rank < tree->next->rank;
+        invTrees &= tree->rank == tree->root->rank;
+        invTrees &= !(tree->sufmin->root->ckey < first->sufmin->root->ckey);
+        stack.push_back(tree->root);
+    }
+
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        count += node->listSize;
+
+        //Only the roots may have an empty list
+        for (Node* child : {node->left, node->right}) {
+            if (child != NULL) {
+                invTrees &= child->listSize > 0 && !(child->ckey < node->ckey);
+                stack.push_back(child);
+            }
+        }
+    }
+
+    return invTrees && count == nodeCount;
+}
+#endif
+
+template class SoftHeap<int,char>;
+template class SoftHeap<int,int>;
@@ -0,0 +1,98 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#ifdef DEBUG
+#include <assert.h>
+#endif
+
+using namespace std;
+
+#ifndef SOFTHEAP_H
+#define SOFTHEAP_H
+
+//Soft heap after Kaplan and Zwick. At most epsilon * n keys are corrupted
+//which means they were raised and may be extracted too late.
+template <typename K, typename V>
+class SoftHeap final {
+    private:
+        struct Item {
+            K key;
+            V value;
+            Item* next;
+        };
+
+        //All items in the list of a node have a key not above the ckey
+        struct Node {
+            Node *left, *right;
+            Item *head, *tail;
+            unsigned int listSize, size;
+            int rank;
+            K ckey;
+        };
+
+        //The trees are sorted by rank and the suffix min points
+        //to the tree with the lowest ckey of all following trees
+        struct Tree {
+            Tree *prev, *next, *sufmin;
+            Node* root;
+            int rank;
+        } *first;
+
+        double epsilon;
+        int rankThreshold;
+        int maxRank;
+        size_t nodeCount;
+
+        //Instrumentation of the extracted items
+        unsigned long long extractCount;
+        unsigned long long corruptExtractCount;
+
+        inline void makeHeap();
+        void copyHeap(const SoftHeap<K,V>& orig);
+        void freeHeap();
+        Node* copyNode(Node* node);
+        void freeNode(Node* node);
+
+        void meldList(Tree* otherFirst, int otherRank);
+        void repeatedCombine(int rank);
+        void updateSuffixMin(Tree* tree);
+        void insertTree(Tree* tree, Tree* before);
+        void removeTree(Tree* tree);
+
+        Node* combine(Node* a, Node* b);
+        void sift(Node* node);
+        inline bool leaf(Node* node) const;
+
+    public:
+        SoftHeap(double epsilon = 0.1);
+        SoftHeap(const SoftHeap<K,V>& orig);
+        SoftHeap<K,V>& operator=(const SoftHeap<K,V>& rhs);
+        ~SoftHeap();
+
+        bool isEmpty() const;
+        void insert(K key, V value);
+        void meld(SoftHeap<K,V>* other);
+
+        V getMin() const;
+        V extractMin();
+
+        size_t size() const;
+        double getEpsilon() const;
+
+        size_t corruptedCount() const;
+        double corruptionRatio() const;
+        double extractCorruptionRatio() const;
+
+        #ifdef DEBUG
+        bool invariant();
+        #endif
+
+};
+
+#endif /* SOFTHEAP_H */
@@ -0,0 +1,340 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "staticfibheap.h"
+
+template <typename K, typename V, size_t N>
+constexpr typename StaticFibonacciHeap<K,V,N>::Index StaticFibonacciHeap<K,V,N>::nil;
+
+template <typename K, typename V, size_t N>
+constexpr unsigned int StaticFibonacciHeap<K,V,N>::maxTrees;
+
+template <typename K, typename V, size_t N>
+void StaticFibonacciHeap<K,V,N>::makeHeap() {
+    rootlist = nil;
+    min = nil;
+    nodeCount = 0;
+
+    //Chain all nodes into the free list
+    for (size_t i = 0; i < N; i++) {
+        nodes[i].next = (Index)(i + 1);
+    }
+
+    freeList = (N > 0) ? 0 : nil;
+}
+
+template <typename K, typename V, size_t N>
+StaticFibonacciHeap<K,V,N>::StaticFibonacciHeap() {
+    makeHeap();
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::isEmpty() const {
+    return rootlist == nil;
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::isFull() const {
+    return freeList == nil;
+}
+
+template <typename K, typename V, size_t N>
+size_t StaticFibonacciHeap<K,V,N>::size() const {
+    return nodeCount;
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::insert(K key, V value) {
+    //Report the exhausted capacity to the caller
+    if (isFull()) {
+        return false;
+    }
+
+    Index index = freeList;
+    Node& node = at(index);
+    freeList = node.next;
+
+    //Initialize the node values
+    node.prev = index;
+    node.next = index;
+    node.child = nil;
+    node.parent = nil;
+    node.key = key;
+    node.value = value;
+    node.degree = 0;
+    node.marked = false;
+
+    //Meld the node into the rootlist
+    meldNode(index);
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    return true;
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::meld(StaticFibonacciHeap<K,V,N>* other) {
+    //Nodes can not be shared between two arrays so they are copied
+    if (other == NULL || other == this || nodeCount + other->nodeCount > N) {
+        return false;
+    }
+
+    if (other->isEmpty()) {
+        return true;
+    }
+
+    //Copy every node of the other heap into a free node of this heap,
+    //the prev index of the other node keeps the index of its copy
+    Core::forEachNode(other->links(), other->rootlist, [&](Index index) {
+        Index copy = freeList;
+        freeList = at(copy).next;
+
+        at(copy) = other->at(index);
+        other->at(index).prev = copy;
+    });
+
+    auto copyOf = [&](Index index) {
+        return (index == nil) ? nil : other->at(index).prev;
+    };
+
+    //Translate the links of the copies, the tree shapes are unchanged
+    Core::forEachNode(other->links(), other->rootlist, [&](Index index) {
+        Node& node = at(copyOf(index));
+        node.prev = copyOf(node.prev);
+        node.next = copyOf(node.next);
+        node.child = copyOf(node.child);
+        node.parent = copyOf(node.parent);
+    });
+
+    //Concatenate both rootlists and update the min index
+    if (rootlist == nil || other->at(other->min).key < at(min).key) {
+        min = copyOf(other->min);
+    }
+
+    Core::spliceList(links(), rootlist, copyOf(other->rootlist));
+    nodeCount += other->nodeCount;
+    other->makeHeap();
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+
+    return true;
+}
+
+template <typename K, typename V, size_t N>
+void StaticFibonacciHeap<K,V,N>::meldNode(Index node) {
+    if (rootlist == nil) {
+        rootlist = min = node;
+
+    } else {
+        //Append the node to the rootlist
+        Core::appendNode(links(), rootlist, node);
+
+        //Update the min index
+        if (at(node).key < at(min).key) {
+            min = node;
+        }
+    }
+
+    nodeCount++;
+}
+
+template <typename K, typename V, size_t N>
+V StaticFibonacciHeap<K,V,N>::getMin() const {
+    if (min == nil) {
+        //Empty rootlist
+        return (V)0;
+    } else {
+        return at(min).value;
+    }
+}
+
+template <typename K, typename V, size_t N>
+V StaticFibonacciHeap<K,V,N>::extractMin() {
+    if (min == nil) {
+        //Empty rootlist
+        return (V)0;
+    } else {
+        //Remove the min node and add all its childs to the rootlist
+        V minValue = at(min).value;
+        Core::removeRoot(links(), rootlist, min);
+
+        //Return the node to the free list
+        at(min).next = freeList;
+        freeList = min;
+        nodeCount--;
+
+        consolidate();
+        return minValue;
+    }
+}
+
+template <typename K, typename V, size_t N>
+void StaticFibonacciHeap<K,V,N>::consolidate() {
+    //Empty heap or single node
+    if (nodeCount <= 1) {
+        min = rootlist;
+        return;
+    }
+
+    //The degree table size is a compile time bound of the capacity
+    Index trees[maxTrees];
+
+    //Link rootlist nodes with the same degree
+    FibonacciNoMirror noMirror;
+    Core::linkRoots(links(), rootlist, trees, maxTrees, noMirror);
+
+    //Create the new rootlist
+    min = Core::rebuildRoots(links(), rootlist, trees, maxTrees, true);
+
+    #ifdef DEBUG
+    assert (invariant());
+    #endif
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::decreaseKey(V value, K newKey) {
+    Index node = isEmpty() ? nil : find(rootlist, value);
+
+    //Check that the node exists and the new key is smaller
+    if (node != nil && newKey < at(node).key) {
+        at(node).key = newKey;
+
+        //Update the min index
+        if (newKey < at(min).key) {
+            min = node;
+        }
+
+        //Done when the node is in the rootlist or the parent still has a lower key
+        if (at(node).parent != nil && at(at(node).parent).key > newKey) {
+            //Repair the heap order
+            Core::cascadingCut(links(), rootlist, node);
+        }
+
+        #ifdef DEBUG
+        assert (invariant());
+        #endif
+
+        return true;
+    } else {
+        return false;
+    }
+}
+
+template <typename K, typename V, size_t N>
+typename StaticFibonacciHeap<K,V,N>::Index StaticFibonacciHeap<K,V,N>::find(Index list, V value) const {
+    Index curNode = list;
+
+    do {
+        if (at(curNode).value == value) {
+            return curNode;
+        }
+
+        //Recursive search for the child lists
+        if (at(curNode).child != nil) {
+            Index childSearch = find(at(curNode).child, value);
+
+            if (childSearch != nil) {
+                return childSearch;
+            }
+        }
+
+        curNode = at(curNode).next;
+    } while (curNode != list);
+
+    return nil;
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::remove(V value) {
+    if (isEmpty()) {
+        return false;
+    }
+
+    //Decrease the key of the target node to become the new min node
+    if (decreaseKey(value, at(min).key - (K)1)) {
+        extractMin();
+        return true;
+    }
+
+    return false;
+}
+
+#ifdef DEBUG
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::invariant() {
+    if (isEmpty()) {
+        return rootlist == nil && min == nil && nodeCount == 0;
+
+    } else {
+        bool invNodeCount = (invariantNodeCount(rootlist) == nodeCount);
+        bool invNonEmpty = min != nil && nodeCount > 0;
+
+        return invNodeCount && invNonEmpty && invariantList(rootlist);
+    }
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::invariantList(Index node) {
+    Index curNode = node;
+    bool invNodes = true;
+
+    do {
+        const Node& n = at(curNode);
+
+        //Chaining of the list and the min index
+        invNodes &= at(n.next).prev == curNode && at(n.prev).next == curNode;
+        invNodes &= !(n.key < at(min).key);
+
+        //Recursive descent for trees
+        if (n.child != nil) {
+            invNodes &= at(n.child).parent == curNode;
+            invNodes &= invariantHeapOrder(n.child, n.key);
+            invNodes &= invariantList(n.child);
+        }
+
+        curNode = n.next;
+    } while (curNode != node);
+
+    return invNodes;
+}
+
+template <typename K, typename V, size_t N>
+bool StaticFibonacciHeap<K,V,N>::invariantHeapOrder(Index node, K key) {
+    Index curNode = node;
+    bool heapOrder = true;
+
+    do {
+        heapOrder &= !(at(curNode).key < key);
+        curNode = at(curNode).next;
+    } while (curNode != node);
+
+    return heapOrder;
+}
+
+template <typename K, typename V, size_t N>
+unsigned int StaticFibonacciHeap<K,V,N>::invariantNodeCount(Index node) {
+    unsigned int nodeSum = 0;
+    Index curNode = node;
+
+    do {
+        nodeSum++;
+
+        if (at(curNode).child != nil) {
+            nodeSum += invariantNodeCount(at(curNode).child);
+        }
+
+        curNode = at(curNode).next;
+    } while (curNode != node);
+
+    return nodeSum;
+}
+#endif
+
+template class StaticFibonacciHeap<int,char,64>;
+template class StaticFibonacciHeap<int,int,8192>;
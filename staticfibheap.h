@@ -0,0 +1,94 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "fibheap.h"
+
+#ifdef DEBUG
+#include <assert.h>
+#endif
+
+using namespace std;
+
+#ifndef STATICFIBHEAP_H
+#define STATICFIBHEAP_H
+
+//Smallest unsigned type that can address N nodes and the nil index
+template <size_t N>
+using StaticFibIndex = typename conditional<(N < UINT8_MAX), uint8_t,
+                       typename conditional<(N < UINT16_MAX), uint16_t, uint32_t>::type>::type;
+
+template <typename K, typename V, size_t N>
+class StaticFibonacciHeap final {
+    //The largest index type must still have a value left for nil
+    static_assert(N < UINT32_MAX, "StaticFibonacciHeap capacity exceeds the index width");
+
+    private:
+        typedef StaticFibIndex<N> Index;
+
+        //Index value used instead of a NULL pointer
+        static constexpr Index nil = (Index)N;
+
+        //Size of the degree table used by consolidate
+        static constexpr unsigned int maxTrees = fibheapMaxDegree(N) + 1;
+
+        struct Node {
+            Index prev, next, child, parent;
+            K key;
+            V value;
+            bool marked;
+            uint8_t degree;
+        };
+
+        //The tree algorithms are shared with the FibonacciHeap
+        typedef FibonacciIndexLinks<Node,Index,nil> Links;
+        typedef FibonacciCore<Links> Core;
+
+        array<Node, N> nodes;
+        Index rootlist, min;
+
+        //Unused nodes are chained with their next index
+        Index freeList;
+        Index nodeCount;
+
+        inline void makeHeap();
+        inline Node& at(Index index) { return nodes[index]; };
+        inline const Node& at(Index index) const { return nodes[index]; };
+        inline Links links() { return Links{nodes.data()}; };
+
+        void meldNode(Index node);
+        void consolidate();
+
+        Index find(Index list, V value) const;
+
+    public:
+        StaticFibonacciHeap();
+
+        bool isEmpty() const;
+        bool isFull() const;
+        size_t size() const;
+        static constexpr size_t capacity() { return N; };
+
+        bool insert(K key, V value);
+        bool meld(StaticFibonacciHeap<K,V,N>* other);
+
+        V getMin() const;
+        V extractMin();
+
+        bool decreaseKey(V value, K newKey);
+        bool remove(V value);
+
+        #ifdef DEBUG
+        bool invariant();
+        bool invariantList(Index node);
+        bool invariantHeapOrder(Index node, K key);
+        unsigned int invariantNodeCount(Index node);
+        #endif
+
+};
+
+#endif /* STATICFIBHEAP_H */
@@ -0,0 +1,243 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "timerqueue.h"
+
+template <typename T, typename V>
+TimerQueue<T,V>::TimerQueue(T resolution) {
+    this->resolution = resolution;
+    freeSlot = UINT32_MAX;
+    active = 0;
+    cancelled = 0;
+}
+
+template <typename T, typename V>
+bool TimerQueue<T,V>::isEmpty() const {
+    return active == 0;
+}
+
+template <typename T, typename V>
+size_t TimerQueue<T,V>::size() const {
+    return active;
+}
+
+template <typename T, typename V>
+T TimerQueue<T,V>::getResolution() const {
+    return resolution;
+}
+
+template <typename T, typename V>
+T TimerQueue<T,V>::nextDeadline() const {
+    return heap.getMinKey();
+}
+
+template <typename T, typename V>
+uint32_t TimerQueue<T,V>::allocateSlot() {
+    if (freeSlot != UINT32_MAX) {
+        uint32_t slot = freeSlot;
+        freeSlot = slots[slot].position;
+        return slot;
+    }
+
+    slots.push_back(Slot());
+    slots.back().generation = 0;
+    return (uint32_t)(slots.size() - 1);
+}
+
+template <typename T, typename V>
+void TimerQueue<T,V>::releaseSlot(uint32_t slot) {
+    //Tokens of the old timer do not match the new generation
+    slots[slot].state = FREE;
+    slots[slot].generation++;
+    slots[slot].position = freeSlot;
+    freeSlot = slot;
+}
+
+template <typename T, typename V>
+uint32_t TimerQueue<T,V>::bucketFor(T deadline) {
+    //Round up to the next multiple of the resolution
+    T remainder = deadline % resolution;
+    T key = (remainder == T()) ? deadline : deadline - remainder + resolution;
+
+    auto it = bucketIndex.find(key);
+
+    if (it != bucketIndex.end()) {
+        return it->second;
+    }
+
+    uint32_t bucket;
+
+    if (!freeBuckets.empty()) {
+        bucket = freeBuckets.back();
+        freeBuckets.pop_back();
+    } else {
+        buckets.push_back(Bucket());
+        bucket = (uint32_t)(buckets.size() - 1);
+    }
+
+    buckets[bucket].deadline = key;
+    bucketIndex[key] = bucket;
+    heap.insert(key, bucket);
+
+    return bucket;
+}
+
+template <typename T, typename V>
+typename TimerQueue<T,V>::Token TimerQueue<T,V>::schedule(T deadline, V payload) {
+    uint32_t index = allocateSlot();
+    Slot& slot = slots[index];
+
+    slot.deadline = deadline;
+    slot.payload = payload;
+    slot.state = ACTIVE;
+
+    if (resolution == T()) {
+        slot.handle = heap.insert(deadline, index);
+
+    } else {
+        uint32_t bucket = bucketFor(deadline);
+        slot.bucket = bucket;
+        slot.position = (uint32_t)buckets[bucket].slots.size();
+        buckets[bucket].slots.push_back(index);
+    }
+
+    active++;
+    return Token(index, slot.generation);
+}
+
+template <typename T, typename V>
+bool TimerQueue<T,V>::cancel(Token token) {
+    if (token.slot >= slots.size()) {
+        return false;
+    }
+
+    Slot& slot = slots[token.slot];
+
+    //Fired, cancelled or reused slots
+    if (slot.generation != token.generation || slot.state != ACTIVE) {
+        return false;
+    }
+
+    active--;
+
+    if (resolution == T()) {
+        //Lazy deletion, the node is dropped when it expires
+        slot.state = CANCELLED;
+        cancelled++;
+
+        //Most timers are cancelled, so the heap is rebuilt when the
+        //cancelled nodes outnumber the active ones
+        if (cancelled > active && cancelled >= 64) {
+            rebuild();
+        }
+
+    } else {
+        //Remove the timer from its bucket with a swap in O(1)
+        vector<uint32_t>& bucketSlots = buckets[slot.bucket].slots;
+        uint32_t last = bucketSlots.back();
+
+        bucketSlots[slot.position] = last;
+        slots[last].position = slot.position;
+        bucketSlots.pop_back();
+
+        releaseSlot(token.slot);
+    }
+
+    return true;
+}
+
+template <typename T, typename V>
+bool TimerQueue<T,V>::reschedule(Token& token, T deadline) {
+    if (token.slot >= slots.size()) {
+        return false;
+    }
+
+    Slot& slot = slots[token.slot];
+
+    if (slot.generation != token.generation || slot.state != ACTIVE) {
+        return false;
+    }
+
+    //Earlier deadlines decrease the key through the handle
+    if (resolution == T() && deadline < slot.deadline) {
+        slot.deadline = deadline;
+        return heap.decreaseKey(slot.handle, deadline);
+    }
+
+    V payload = slot.payload;
+    cancel(token);
+    token = schedule(deadline, payload);
+    return true;
+}
+
+template <typename T, typename V>
+void TimerQueue<T,V>::rebuild() {
+    //Only the timers in the heap are visited, the slot vector keeps
+    //the size of the largest number of timers ever scheduled
+    expired.clear();
+    heap.forEach([this](T deadline, uint32_t index) {
+        expired.push_back(make_pair(deadline, index));
+    });
+
+    heap = Heap();
+
+    for (const pair<T,uint32_t>& node : expired) {
+        if (slots[node.second].state == CANCELLED) {
+            releaseSlot(node.second);
+        } else {
+            slots[node.second].handle = heap.insert(node.first, node.second);
+        }
+    }
+
+    expired.clear();
+    cancelled = 0;
+}
+
+template <typename T, typename V>
+void TimerQueue<T,V>::expire(T now) {
+    fired.clear();
+    expired.clear();
+
+    //All expired nodes are extracted with a single consolidation
+    heap.extractUpTo(now, expired);
+
+    for (const pair<T,uint32_t>& node : expired) {
+        if (resolution == T()) {
+            Slot& slot = slots[node.second];
+
+            if (slot.state == ACTIVE) {
+                fired.push_back(make_pair(slot.deadline, slot.payload));
+                active--;
+            } else {
+                cancelled--;
+            }
+
+            releaseSlot(node.second);
+
+        } else {
+            Bucket& bucket = buckets[node.second];
+            size_t first = fired.size();
+
+            for (uint32_t index : bucket.slots) {
+                fired.push_back(make_pair(slots[index].deadline, slots[index].payload));
+                releaseSlot(index);
+            }
+
+            active -= bucket.slots.size();
+
+            //Timers of a bucket fire in the order of their deadlines
+            stable_sort(fired.begin() + first, fired.end(), [](const pair<T,V>& a, const pair<T,V>& b) {
+                return a.first < b.first;
+            });
+
+            bucket.slots.clear();
+            bucketIndex.erase(bucket.deadline);
+            freeBuckets.push_back(node.second);
+        }
+    }
+}
+
+template class TimerQueue<long long,int>;
+template class TimerQueue<int,int>;
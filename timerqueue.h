@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include "fibheap.h"
+
+using namespace std;
+
+#ifndef TIMERQUEUE_H
+#define TIMERQUEUE_H
+
+//Timers with deadlines of type T and payloads of type V. Cancelled timers
+//stay in the heap until they expire or until they outnumber the active
+//timers, then the heap is rebuilt. With a resolution the deadlines are
+//rounded up to buckets and all timers of a bucket share one heap node.
+//The bucketing requires non-negative deadlines.
+template <typename T, typename V>
+class TimerQueue final {
+    private:
+        typedef FibonacciHeap<T,uint32_t> Heap;
+
+        enum SlotState : uint8_t { FREE, ACTIVE, CANCELLED };
+
+        struct Slot {
+            T deadline;
+            V payload;
+            typename Heap::Handle handle;
+            uint32_t generation;
+
+            //Bucket of the timer and the index in the bucket, the
+            //position also links the free slots
+            uint32_t bucket;
+            uint32_t position;
+            SlotState state;
+        };
+
+        struct Bucket {
+            T deadline;
+            vector<uint32_t> slots;
+        };
+
+        Heap heap;
+        T resolution;
+
+        vector<Slot> slots;
+        uint32_t freeSlot;
+
+        vector<Bucket> buckets;
+        vector<uint32_t> freeBuckets;
+        unordered_map<T,uint32_t> bucketIndex;
+
+        size_t active;
+        size_t cancelled;
+
+        //Reused buffers for the expiration and the rebuild
+        vector<pair<T,uint32_t>> expired;
+        vector<pair<T,V>> fired;
+
+        uint32_t allocateSlot();
+        void releaseSlot(uint32_t slot);
+        uint32_t bucketFor(T deadline);
+        void rebuild();
+        void expire(T now);
+
+    public:
+        //Reference to a scheduled timer for the cancellation
+        class Token {
+            private:
+                friend class TimerQueue<T,V>;
+                uint32_t slot;
+                uint32_t generation;
+
+                Token(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+
+            public:
+                Token() : slot(UINT32_MAX), generation(0) {}
+        };
+
+        //A resolution of zero keeps the exact deadlines
+        TimerQueue(T resolution = T());
+
+        TimerQueue(const TimerQueue<T,V>&) = delete;
+        TimerQueue<T,V>& operator=(const TimerQueue<T,V>&) = delete;
+
+        bool isEmpty() const;
+        size_t size() const;
+        T getResolution() const;
+
+        //Lower bound for the next deadline, cancelled timers may be included.
+        //With a resolution it is the deadline of the next bucket, which is
+        //the earliest deadline in it rounded up to the resolution.
+        T nextDeadline() const;
+
+        Token schedule(T deadline, V payload);
+        bool cancel(Token token);
+
+        //Earlier exact deadlines keep the token, otherwise it is replaced
+        bool reschedule(Token& token, T deadline);
+
+        //Write all timers up to now as deadline and payload pairs
+        template <typename OutputIt>
+        OutputIt popExpired(T now, OutputIt out);
+};
+
+template <typename T, typename V>
+template <typename OutputIt>
+OutputIt TimerQueue<T,V>::popExpired(T now, OutputIt out) {
+    expire(now);
+
+    for (const pair<T,V>& timer : fired) {
+        *out++ = timer;
+    }
+
+    return out;
+}
+
+#endif /* TIMERQUEUE_H */
@@ -0,0 +1,85 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "fibheap.h"
+#include "pairingheap.h"
+#include "rpheap.h"
+#include "coalescingheap.h"
+#include "fuzz.h"
+using namespace std;
+
+//Run the seeds until the first failure and print the minimized operations
+template <typename Heap>
+int fuzz(size_t count, unsigned int seed, unsigned int seeds, const FuzzConfig& config) {
+    vector<FuzzOp> ops;
+    string error;
+
+    for (unsigned int s = seed; s < seed + seeds; s++) {
+        auto start = chrono::steady_clock::now();
+
+        if (!fuzzRandom<Heap>(count, s, config, ops, error)) {
+            cout << "Seed " << s << " failed after " << ops.size() << " operations: " << error << endl;
+
+            vector<FuzzOp> minimized = fuzzMinimize<Heap>(ops, config.heaps);
+            cout << "Minimized to " << minimized.size() << " operations:" << endl;
+
+            for (const FuzzOp& op : minimized) {
+                cout << "    " << op << endl;
+            }
+
+            return 1;
+        }
+
+        auto end = chrono::steady_clock::now();
+        cout << "Seed " << s << ": " << count << " operations passed in "
+             << chrono::duration<double>(end - start).count() << " s" << endl;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "-h") {
+        cerr << "Usage: " << argv[0] << " [fibonacci|pairing|rankpairing|coalescing] [operations] [seed] [seeds] [maxSize]" << endl;
+        return 1;
+    }
+
+    string engine = (argc > 1) ? argv[1] : "fibonacci";
+    size_t count = (argc > 2) ? strtoull(argv[2], NULL, 10) : 1000000;
+    unsigned int seed = (argc > 3) ? atoi(argv[3]) : 1;
+    unsigned int seeds = (argc > 4) ? atoi(argv[4]) : 1;
+
+    FuzzConfig config;
+
+    //Sizes above the default select the large heap mode
+    if (argc > 5) {
+        size_t maxSize = strtoull(argv[5], NULL, 10);
+
+        if (maxSize > config.maxSize) {
+            config = FuzzConfig::largeHeaps(maxSize);
+        } else {
+            config.maxSize = maxSize;
+        }
+    }
+
+    if (engine == "fibonacci") {
+        return fuzz<FibonacciHeap<int,int>>(count, seed, seeds, config);
+    } else if (engine == "pairing") {
+        return fuzz<PairingHeap<int,int>>(count, seed, seeds, config);
+    } else if (engine == "rankpairing") {
+        return fuzz<RankPairingHeap<int,int>>(count, seed, seeds, config);
+    } else if (engine == "coalescing") {
+        return fuzz<CoalescingHeap<int,int>>(count, seed, seeds, config);
+    }
+
+    cerr << "Unknown engine: " << engine << endl;
+    return 1;
+}
@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "kwaymerge.h"
+using namespace std;
+
+static void usage(const char* program) {
+    cerr << "Usage: " << program << " [-k field] [-b bytes] [-o output] [--no-mmap] [-v] <input>..." << endl
+         << "Merges inputs sorted by the integer key in the field (default 1), - reads stdin" << endl;
+}
+
+int main(int argc, char** argv) {
+    unsigned int keyField = 1;
+    size_t bufferSize = 1 << 20;
+    bool map = true;
+    bool verbose = false;
+    string output;
+    vector<string> paths;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if ((arg == "-k" || arg == "-b" || arg == "-o") && i + 1 < argc) {
+            string value = argv[++i];
+
+            if (arg == "-k") {
+                keyField = (unsigned int)strtoul(value.c_str(), NULL, 10);
+            } else if (arg == "-b") {
+                bufferSize = (size_t)strtoull(value.c_str(), NULL, 10);
+            } else {
+                output = value;
+            }
+
+        } else if (arg == "--no-mmap") {
+            map = false;
+        } else if (arg == "-v") {
+            verbose = true;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if (paths.empty() || keyField == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int fd = STDOUT_FILENO;
+
+    if (!output.empty()) {
+        fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fd < 0) {
+            perror(output.c_str());
+            return 1;
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<MergeInput> inputs(paths.size());
+    string error;
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!inputs[i].open(paths[i], map, bufferSize, error)) {
+            cerr << error << endl;
+            return 1;
+        }
+    }
+
+    MergeWriter writer(fd);
+    size_t records;
+
+    if (!kwayMerge(inputs, writer, keyField, records, error)) {
+        cerr << error << endl;
+        return 1;
+    }
+
+    if (fd != STDOUT_FILENO && close(fd) != 0) {
+        perror(output.c_str());
+        return 1;
+    }
+
+    if (verbose) {
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cerr << records << " records from " << paths.size() << " inputs in " << seconds << " s with "
+             << writer.writeCount() << " writes" << endl;
+    }
+
+    return 0;
+}
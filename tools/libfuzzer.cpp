@@ -0,0 +1,50 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "fibheap.h"
+#include "fuzz.h"
+using namespace std;
+
+//Entry point for coverage guided fuzzing with libFuzzer
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const unsigned int heapCount = 3;
+    vector<FuzzOp> ops = fuzzDecode(data, size, heapCount);
+
+    DifferentialFuzzer<FibonacciHeap<int,int>> fuzzer(heapCount);
+    string error;
+    size_t failed = fuzzer.run(ops, error);
+
+    if (failed < ops.size()) {
+        cerr << "Operation " << failed << " failed: " << error << endl;
+
+        for (const FuzzOp& op : fuzzMinimize<FibonacciHeap<int,int>>(ops, heapCount)) {
+            cerr << "    " << op << endl;
+        }
+
+        abort();
+    }
+
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+//Replay inputs without libFuzzer, for example a crash file
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        ifstream file(argv[i], ios::binary);
+        vector<uint8_t> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+
+#include "fibheap.h"
+#include "pairingheap.h"
+#include "rpheap.h"
+#include "trace.h"
+using namespace std;
+
+typedef TraceRecord<int,int> Record;
+
+static const char* opNames[] = {"insert", "extractMin", "decreaseKey", "remove", "meld"};
+static const int opCount = 5;
+
+//Execute all records and measure the latency of every operation
+template <typename Heap>
+double replay(const vector<Record>& records, vector<vector<double>>& latencies) {
+    vector<unique_ptr<Heap>> heaps;
+
+    //Heaps are created when they are referenced first
+    auto heapAt = [&heaps](uint32_t id) {
+        while (heaps.size() <= id) {
+            heaps.emplace_back(new Heap());
+        }
+
+        return heaps[id].get();
+    };
+
+    auto start = chrono::steady_clock::now();
+
+    for (const Record& rec : records) {
+        Heap* heap = heapAt(rec.heap);
+        Heap* other = (rec.op == TRACE_MELD) ? heapAt(rec.other) : NULL;
+        auto opStart = chrono::steady_clock::now();
+
+        switch (rec.op) {
+            case TRACE_INSERT: heap->insert(rec.key, rec.value); break;
+            case TRACE_EXTRACT_MIN: heap->extractMin(); break;
+            case TRACE_DECREASE_KEY: heap->decreaseKey(rec.value, rec.key); break;
+            case TRACE_REMOVE: heap->remove(rec.value); break;
+            case TRACE_MELD: heap->meld(other); break;
+        }
+
+        auto opEnd = chrono::steady_clock::now();
+        latencies[rec.op].push_back(chrono::duration<double, nano>(opEnd - opStart).count());
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+double percentile(const vector<double>& sorted, double p) {
+    return sorted[min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <trace> [fibonacci|pairing|rankpairing]" << endl;
+        return 1;
+    }
+
+    string engine = (argc > 2) ? argv[2] : "fibonacci";
+    ifstream file(argv[1], ios::binary);
+    TraceReader<int,int> reader(file);
+
+    if (!reader.isValid()) {
+        cerr << "No valid <int,int> trace: " << argv[1] << endl;
+        return 1;
+    }
+
+    //The trace is loaded first to measure only the heap operations
+    vector<Record> records;
+    Record rec;
+
+    while (reader.read(rec)) {
+        if (rec.op >= opCount) {
+            cerr << "Unknown operation in the trace" << endl;
+            return 1;
+        }
+
+        records.push_back(rec);
+    }
+
+    vector<vector<double>> latencies(opCount);
+    double seconds;
+
+    if (engine == "fibonacci") {
+        seconds = replay<FibonacciHeap<int,int>>(records, latencies);
+    } else if (engine == "pairing") {
+        seconds = replay<PairingHeap<int,int>>(records, latencies);
+    } else if (engine == "rankpairing") {
+        seconds = replay<RankPairingHeap<int,int>>(records, latencies);
+    } else {
+        cerr << "Unknown engine: " << engine << endl;
+        return 1;
+    }
+
+    cout << "Replayed " << records.size() << " operations on the " << engine << " heap in "
+         << fixed << setprecision(3) << seconds * 1000 << " ms ("
+         << setprecision(0) << records.size() / max(seconds, 1e-9) << " ops/s)" << endl;
+
+    cout << setw(12) << "operation" << setw(12) << "count" << setw(12) << "mean ns"
+         << setw(12) << "p50 ns" << setw(12) << "p99 ns" << setw(12) << "max ns" << endl;
+
+    for (int op = 0; op < opCount; op++) {
+        vector<double>& times = latencies[op];
+
+        if (times.empty()) {
+            continue;
+        }
+
+        sort(times.begin(), times.end());
+        double sum = 0;
+
+        for (double t : times) {
+            sum += t;
+        }
+
+        cout << setw(12) << opNames[op] << setw(12) << times.size() << setprecision(0)
+             << setw(12) << sum / times.size()
+             << setw(12) << percentile(times, 0.5)
+             << setw(12) << percentile(times, 0.99)
+             << setw(12) << times.back() << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include "trace.h"
+
+//Header of a trace file
+static const char traceMagic[4] = {'F', 'H', 'T', 'R'};
+static const uint8_t traceVersion = 1;
+
+template <typename K, typename V>
+TraceWriter<K,V>::TraceWriter(ostream& out) {
+    this->out = &out;
+    heapCount = 0;
+    recordCount = 0;
+
+    out.write(traceMagic, sizeof(traceMagic));
+    put(traceVersion);
+    put((uint8_t)sizeof(K));
+    put((uint8_t)sizeof(V));
+}
+
+template <typename K, typename V>
+template <typename T>
+void TraceWriter<K,V>::put(const T& field) {
+    out->write(reinterpret_cast<const char*>(&field), sizeof(T));
+}
+
+template <typename K, typename V>
+uint32_t TraceWriter<K,V>::addHeap() {
+    return heapCount++;
+}
+
+template <typename K, typename V>
+void TraceWriter<K,V>::write(const TraceRecord<K,V>& record) {
+    put(record.op);
+    put(record.heap);
+
+    //Only the fields used by the operation are stored
+    switch (record.op) {
+        case TRACE_INSERT:
+        case TRACE_DECREASE_KEY:
+            put(record.key);
+            put(record.value);
+            break;
+
+        case TRACE_REMOVE:
+            put(record.value);
+            break;
+
+        case TRACE_MELD:
+            put(record.other);
+            break;
+
+        case TRACE_EXTRACT_MIN:
+            break;
+    }
+
+    recordCount++;
+}
+
+template <typename K, typename V>
+size_t TraceWriter<K,V>::size() const {
+    return recordCount;
+}
+
+template <typename K, typename V>
+TraceReader<K,V>::TraceReader(istream& in) {
+    this->in = &in;
+
+    char magic[sizeof(traceMagic)];
+    uint8_t version, keySize, valueSize;
+
+    valid = (bool)in.read(magic, sizeof(magic))
+        && equal(magic, magic + sizeof(magic), traceMagic)
+        && get(version) && version == traceVersion
+        && get(keySize) && keySize == sizeof(K)
+        && get(valueSize) && valueSize == sizeof(V);
+}
+
+template <typename K, typename V>
+template <typename T>
+bool TraceReader<K,V>::get(T& field) {
+    return (bool)in->read(reinterpret_cast<char*>(&field), sizeof(T));
+}
+
+template <typename K, typename V>
+bool TraceReader<K,V>::isValid() const {
+    return valid;
+}
+
+template <typename K, typename V>
+bool TraceReader<K,V>::read(TraceRecord<K,V>& record) {
+    if (!valid || !get(record.op) || !get(record.heap)) {
+        return false;
+    }
+
+    record.other = 0;
+    record.key = K();
+    record.value = V();
+
+    switch (record.op) {
+        case TRACE_INSERT:
+        case TRACE_DECREASE_KEY:
+            return get(record.key) && get(record.value);
+
+        case TRACE_REMOVE:
+            return get(record.value);
+
+        case TRACE_MELD:
+            return get(record.other);
+
+        case TRACE_EXTRACT_MIN:
+            return true;
+    }
+
+    //Unknown operation
+    valid = false;
+    return false;
+}
+
+template class TraceWriter<int,char>;
+template class TraceWriter<int,int>;
+template class TraceReader<int,char>;
+template class TraceReader<int,int>;
@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------
+// MIT License
+// Copyright (c) 2018 Henrik Peters
+// See LICENSE file in the project root for full license information.
+// ---------------------------------------------------------------------
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include "fibheap.h"
+
+using namespace std;
+
+#ifndef TRACE_H
+#define TRACE_H
+
+//Operations stored in a trace
+enum TraceOp : uint8_t {
+    TRACE_INSERT = 0,
+    TRACE_EXTRACT_MIN = 1,
+    TRACE_DECREASE_KEY = 2,
+    TRACE_REMOVE = 3,
+    TRACE_MELD = 4
+};
+
+//A single operation. The heaps of a trace are numbered by their creation.
+//Unused fields are not stored and keep their default value.
+template <typename K, typename V>
+struct TraceRecord {
+    TraceOp op;
+    uint32_t heap;
+    uint32_t other;
+    K key;
+    V value;
+};
+
+//Binary trace format: the header holds a magic number, the format version
+//and the key and value sizes. Every record starts with the operation and
+//the heap number followed by the fields used by the operation.
+template <typename K, typename V>
+class TraceWriter final {
+    private:
+        static_assert(is_trivially_copyable<K>::value && is_trivially_copyable<V>::value,
+                      "Traces store keys and values as raw bytes");
+
+        ostream* out;
+        uint32_t heapCount;
+        size_t recordCount;
+
+        template <typename T>
+        inline void put(const T& field);
+
+    public:
+        TraceWriter(ostream& out);
+
+        TraceWriter(const TraceWriter<K,V>&) = delete;
+        TraceWriter<K,V>& operator=(const TraceWriter<K,V>&) = delete;
+
+        //Number for the next heap of the trace
+        uint32_t addHeap();
+
+        void write(const TraceRecord<K,V>& record);
+        size_t size() const;
+};
+
+template <typename K, typename V>
+class TraceReader final {
+    private:
+        istream* in;
+        bool valid;
+
+        template <typename T>
+        inline bool get(T& field);
+
+    public:
+        //Checks the header of the trace
+        TraceReader(istream& in);
+
+        //False for a wrong header
+        bool isValid() const;
+
+        //False at the end of the trace or for a truncated record
+        bool read(TraceRecord<K,V>& record);
+};
+
+//Heap that writes all modifying operations to a trace. The recording
+//works with all engines that provide insert, extractMin, decreaseKey,
+//remove and meld. Copies of a traced heap are not traced.
+template <typename K, typename V, template <typename, typename> class Heap = FibonacciHeap>
+class TracedHeap final {
+    private:
+        Heap<K,V> heap;
+        TraceWriter<K,V>* writer;
+        uint32_t id;
+
+        inline void record(TraceOp op, K key, V value, uint32_t other = 0) {
+            TraceRecord<K,V> rec;
+            rec.op = op;
+            rec.heap = id;
+            rec.other = other;
+            rec.key = key;
+            rec.value = value;
+            writer->write(rec);
+        }
+
+    public:
+        TracedHeap(TraceWriter<K,V>* writer) : writer(writer), id(writer->addHeap()) {}
+
+        TracedHeap(const TracedHeap&) = delete;
+        TracedHeap& operator=(const TracedHeap&) = delete;
+
+        bool isEmpty() const { return heap.isEmpty(); }
+        V getMin() const { return heap.getMin(); }
+
+        void insert(K key, V value) {
+            record(TRACE_INSERT, key, value);
+            heap.insert(key, value);
+        }
+
+        V extractMin() {
+            record(TRACE_EXTRACT_MIN, K(), V());
+            return heap.extractMin();
+        }
+
+        bool decreaseKey(V value, K newKey) {
+            record(TRACE_DECREASE_KEY, newKey, value);
+            return heap.decreaseKey(value, newKey);
+        }
+
+        bool remove(V value) {
+            record(TRACE_REMOVE, K(), value);
+            return heap.remove(value);
+        }
+
+        void meld(TracedHeap* other) {
+            record(TRACE_MELD, K(), V(), other->id);
+            heap.meld(&other->heap);
+        }
+
+        //Untraced access to the heap
+        const Heap<K,V>& get() const { return heap; }
+};
+
+#endif /* TRACE_H */